@@ -0,0 +1,189 @@
+#include "ComponentClassifier.h"
+#include <iterator>
+#include <queue>
+#include <utility>
+
+namespace Core {
+    namespace {
+        using ComponentTypes::FILE_NAME_COMPONENTS;
+
+        unsigned char upper(unsigned char c) {
+            return c >= 'a' && c <= 'z' ? static_cast<unsigned char>(c - 'a' + 'A') : c;
+        }
+
+        bool isBoundary(std::string_view text, size_t pos) {
+            return pos >= text.size() || text[pos] == '_' || (text[pos] >= '0' && text[pos] <= '9');
+        }
+
+        // Patterns the constructor adds: each legacyInFiles and "_" + shortType, "_OUTFIT" and
+        // "OUTFIT_" for the OUTFIT row, and each file name pattern
+        constexpr size_t patternCount() {
+            size_t count = std::size(FILE_NAME_COMPONENTS);
+            for (const auto& comp : ComponentTypes::UNIFIED_COMPONENTS) {
+                count += comp.legacyInFiles.empty() ? 0 : 1;
+                count += comp.shortType.empty() ? 0 : 1;
+                count += comp.internalType == "OUTFIT" ? 2 : 0;
+            }
+            return count;
+        }
+
+        static_assert(patternCount() <= 64,
+                      "ComponentClassifier has one bit per pattern in a uint64_t mask; widen the masks before adding table rows");
+
+        int lowestBit(uint64_t mask) {
+            int bit = 0;
+            while (!(mask & 1)) {
+                mask >>= 1;
+                ++bit;
+            }
+            return bit;
+        }
+    }
+
+    ComponentClassifier::ComponentClassifier() {
+        const auto& components = ComponentTypes::UNIFIED_COMPONENTS;
+        for (size_t i = 0; i < std::size(components); ++i) {
+            addPattern(std::string(components[i].legacyInFiles), Detector::Key, i);
+        }
+        size_t outfit = std::size(components);
+        for (size_t i = 0; i < std::size(components); ++i) {
+            if (!components[i].shortType.empty()) {
+                addPattern("_" + std::string(components[i].shortType), Detector::Hash, i);
+            }
+            if (components[i].internalType == "OUTFIT") {
+                outfit = i;
+            }
+        }
+        if (outfit < std::size(components)) {
+            addPattern("_OUTFIT", Detector::HashOutfit, outfit);
+            addPattern("OUTFIT_", Detector::HashOutfit, outfit);
+        }
+        for (size_t i = 0; i < std::size(FILE_NAME_COMPONENTS); ++i) {
+            addPattern(std::string(FILE_NAME_COMPONENTS[i].first), Detector::FileName, i);
+        }
+        compile();
+    }
+
+    const ComponentClassifier& ComponentClassifier::instance() {
+        static const ComponentClassifier classifier;
+        return classifier;
+    }
+
+    void ComponentClassifier::addPattern(std::string text, Detector detector, size_t entry) {
+        if (text.empty()) {
+            return;
+        }
+        uint64_t bit = uint64_t{1} << patterns.size();
+        switch (detector) {
+        case Detector::Key: keyMask |= bit; break;
+        case Detector::Hash: hashMask |= bit; break;
+        case Detector::HashOutfit: hashOutfitMask |= bit; break;
+        case Detector::FileName: fileNameMask |= bit; break;
+        }
+        for (unsigned char c : text) {
+            if (!exactClass[c]) {
+                exactClass[c] = static_cast<uint8_t>(classCount++);
+            }
+        }
+        patterns.push_back({ std::move(text), detector, static_cast<uint16_t>(entry) });
+    }
+
+    void ComponentClassifier::compile() {
+        for (int c = 0; c < 256; ++c) {
+            foldedClass[c] = exactClass[upper(static_cast<unsigned char>(c))];
+        }
+
+        // Trie of the patterns; -1 marks a missing edge until the fail links fill it in
+        auto addState = [this]() {
+            next.insert(next.end(), classCount, -1);
+            output.push_back(0);
+            return static_cast<int32_t>(output.size() - 1);
+        };
+        addState();
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            int32_t state = 0;
+            for (unsigned char c : patterns[i].text) {
+                size_t edge = static_cast<size_t>(state) * classCount + exactClass[c];
+                if (next[edge] < 0) {
+                    int32_t added = addState();
+                    next[edge] = added;
+                }
+                state = next[edge];
+            }
+            output[state] |= uint64_t{1} << i;
+        }
+
+        // Breadth first, so a state's fail target is complete before the state is.
+        // Class 0 never matches a pattern byte; its edge always returns to the root.
+        std::vector<int32_t> fail(output.size(), 0);
+        std::queue<int32_t> pending;
+        for (int cls = 0; cls < classCount; ++cls) {
+            int32_t& target = next[cls];
+            if (target < 0 || cls == 0) {
+                target = 0;
+            }
+            else {
+                pending.push(target);
+            }
+        }
+        while (!pending.empty()) {
+            int32_t state = pending.front();
+            pending.pop();
+            output[state] |= output[fail[state]];
+            for (int cls = 0; cls < classCount; ++cls) {
+                size_t edge = static_cast<size_t>(state) * classCount + cls;
+                int32_t fallback = next[static_cast<size_t>(fail[state]) * classCount + cls];
+                if (next[edge] < 0) {
+                    next[edge] = fallback;
+                }
+                else {
+                    fail[next[edge]] = fallback;
+                    pending.push(next[edge]);
+                }
+            }
+        }
+    }
+
+    int ComponentClassifier::firstMatch(std::string_view text, uint64_t mask) const {
+        int32_t state = 0;
+        uint64_t found = 0;
+        for (unsigned char c : text) {
+            state = next[static_cast<size_t>(state) * classCount + exactClass[c]];
+            found |= output[state];
+        }
+        found &= mask;
+        return found ? lowestBit(found) : -1;
+    }
+
+    const ComponentTypes::UnifiedComponentMapping* ComponentClassifier::classifyKey(std::string_view key) const {
+        int match = firstMatch(key, keyMask);
+        return match < 0 ? nullptr : &ComponentTypes::UNIFIED_COMPONENTS[patterns[match].entry];
+    }
+
+    const ComponentTypes::UnifiedComponentMapping* ComponentClassifier::classifyHash(std::string_view hash) const {
+        // Only the first occurrence of each "_" + shortType has its boundary checked, as
+        // find() did: a later, properly bounded occurrence does not count
+        int32_t state = 0;
+        uint64_t seen = 0;
+        uint64_t bounded = 0;
+        for (size_t pos = 0; pos < hash.size(); ++pos) {
+            state = next[static_cast<size_t>(state) * classCount + foldedClass[static_cast<unsigned char>(hash[pos])]];
+            uint64_t first = output[state] & (hashMask | hashOutfitMask) & ~seen;
+            if (!first) {
+                continue;
+            }
+            seen |= first;
+            if ((first & hashMask) && isBoundary(hash, pos + 1)) {
+                bounded |= first & hashMask;
+            }
+        }
+
+        uint64_t match = bounded ? bounded : seen & hashOutfitMask;
+        return match ? &ComponentTypes::UNIFIED_COMPONENTS[patterns[lowestBit(match)].entry] : nullptr;
+    }
+
+    std::string_view ComponentClassifier::classifyFileName(std::string_view filename) const {
+        int match = firstMatch(filename, fileNameMask);
+        return match < 0 ? std::string_view("UNKNOWN") : FILE_NAME_COMPONENTS[patterns[match].entry].second;
+    }
+}
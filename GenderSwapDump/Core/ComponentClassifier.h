@@ -0,0 +1,62 @@
+#pragma once
+#include "Constants.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core {
+    // Every substring the component detectors look for, compiled once from UNIFIED_COMPONENTS
+    // and the JSON file name table into a single Aho-Corasick automaton. Each pattern carries
+    // a bit naming its detector, so one pass over a key, hash or file name reports every
+    // pattern it contains and the detector keeps the first one in its table's order: the
+    // same answer the per-entry find() loops gave, without their copies.
+    class ComponentClassifier {
+    public:
+        ComponentClassifier();
+
+        static const ComponentClassifier& instance();
+
+        // Script metadata key: the first entry whose legacyInFiles occurs in it
+        // ("DLC_MP_BEACH_M_JBIB_0" -> Torso 2), or nullptr
+        const ComponentTypes::UnifiedComponentMapping* classifyKey(std::string_view key) const;
+
+        // Item hash, ignoring case: the first entry with a shortType whose first "_" + shortType
+        // is followed by the end, '_' or a digit; failing that the OUTFIT entry when "_OUTFIT"
+        // or "OUTFIT_" occurs anywhere; otherwise nullptr
+        const ComponentTypes::UnifiedComponentMapping* classifyHash(std::string_view hash) const;
+
+        // JSON file name: the short component type of the first name pattern it contains
+        // ("female_tops.json" -> "JBIB"), or "UNKNOWN"
+        std::string_view classifyFileName(std::string_view filename) const;
+
+    private:
+        enum class Detector : uint8_t { Key, Hash, HashOutfit, FileName };
+
+        struct Pattern {
+            std::string text;
+            Detector detector;
+            uint16_t entry;  // Row of UNIFIED_COMPONENTS, or of the file name table
+        };
+
+        // Key patterns are matched case-sensitively and hash patterns against the upper-cased
+        // input, so the byte classes come in two tables; bytes no pattern uses share class 0
+        uint8_t exactClass[256]{};
+        uint8_t foldedClass[256]{};
+        int classCount{1};
+
+        std::vector<Pattern> patterns;  // At most 64 (checked at compile time), bit i of a mask is patterns[i]
+        std::vector<int32_t> next;      // classCount transitions per state
+        std::vector<uint64_t> output;   // Patterns ending at each state, through the fail links
+        uint64_t keyMask{0};
+        uint64_t hashMask{0};
+        uint64_t hashOutfitMask{0};
+        uint64_t fileNameMask{0};
+
+        void addPattern(std::string text, Detector detector, size_t entry);
+        void compile();
+
+        // First pattern in `mask` occurring anywhere in `text`
+        int firstMatch(std::string_view text, uint64_t mask) const;
+    };
+}
@@ -0,0 +1,583 @@
+#include "Compression.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    constexpr std::string_view COMPRESSED_SUFFIXES[] = { ".gz", ".zst" };
+
+    // RFC 1951 tables
+    constexpr uint16_t LENGTH_BASE[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr uint8_t LENGTH_EXTRA[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    constexpr uint16_t DISTANCE_BASE[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr uint8_t DISTANCE_EXTRA[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    constexpr uint8_t CODE_LENGTH_ORDER[19] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    constexpr unsigned MAX_CODE_BITS = 15;
+
+    constexpr size_t INITIAL_EXPANSION = 4;  // Output buffer bytes per input byte to start with
+
+    uint32_t read16(const unsigned char* p) {
+        return p[0] | (p[1] << 8);
+    }
+
+    uint32_t read32(const unsigned char* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    // Slicing-by-8 CRC-32 (reflected polynomial 0xEDB88320, as gzip uses)
+    uint32_t crc32(const void* data, size_t size) {
+        static const auto tables = [] {
+            std::array<std::array<uint32_t, 256>, 8> t{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+                }
+                t[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (size_t k = 1; k < 8; ++k) {
+                    t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+                }
+            }
+            return t;
+        }();
+
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint32_t crc = 0xFFFFFFFFu;
+        for (; size >= 8; p += 8, size -= 8) {
+            uint32_t low = read32(p) ^ crc;
+            uint32_t high = read32(p + 4);
+            crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^
+                  tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+                  tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^
+                  tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+        }
+        for (; size > 0; ++p, --size) {
+            crc = (crc >> 8) ^ tables[0][(crc ^ *p) & 0xFF];
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    // LSB-first bit buffer over the compressed bytes. Reading past the end yields zero
+    // bits rather than failing; overrun() tells whether any of them were consumed.
+    class BitReader {
+    public:
+        BitReader(const unsigned char* begin, const unsigned char* end) : p(begin), end(end) {}
+
+        // Tops the buffer up to at least 56 bits
+        void refill() {
+            if (end - p >= 8) {
+                uint64_t word;
+                std::memcpy(&word, p, sizeof(word));
+                bits |= word << count;
+                p += (63 - count) >> 3;
+                count |= 56;
+                return;
+            }
+            while (count <= 56) {
+                if (p < end) {
+                    bits |= static_cast<uint64_t>(*p++) << count;
+                }
+                else {
+                    ++padding;
+                }
+                count += 8;
+            }
+        }
+
+        uint32_t peek(unsigned n) const { return static_cast<uint32_t>(bits & ((1ull << n) - 1)); }
+
+        void consume(unsigned n) {
+            bits >>= n;
+            count -= n;
+        }
+
+        uint32_t take(unsigned n) {
+            if (count < n) {
+                refill();
+            }
+            uint32_t value = peek(n);
+            consume(n);
+            return value;
+        }
+
+        bool overrun() const { return padding * 8 > count; }
+
+        // Drops the rest of the current byte and hands back the whole bytes still buffered,
+        // so stored blocks and the gzip trailer can be read straight from the input
+        const unsigned char* alignToByte() {
+            consume(count & 7);
+            size_t buffered = count / 8;
+            p -= buffered > padding ? buffered - padding : 0;
+            bits = 0;
+            count = 0;
+            padding = 0;
+            return p;
+        }
+
+        void seek(const unsigned char* position) { p = position; }
+        const unsigned char* limit() const { return end; }
+
+    private:
+        const unsigned char* p;
+        const unsigned char* end;
+        uint64_t bits{0};
+        unsigned count{0};
+        size_t padding{0};
+    };
+
+    // Canonical Huffman decoder: codes up to FAST_BITS long resolve with one table lookup,
+    // longer ones (rare in practice) walk the per-length counts
+    class Huffman {
+    public:
+        static constexpr unsigned FAST_BITS = 10;
+
+        bool build(const uint8_t* lengths, unsigned n) {
+            std::fill(std::begin(counts), std::end(counts), 0);
+            std::fill(std::begin(fast), std::end(fast), 0);
+            for (unsigned i = 0; i < n; ++i) {
+                ++counts[lengths[i]];
+            }
+            counts[0] = 0;
+
+            // Over-subscribed sets are invalid; incomplete ones are allowed (a single distance code)
+            int left = 1;
+            for (unsigned len = 1; len <= MAX_CODE_BITS; ++len) {
+                left = (left << 1) - counts[len];
+                if (left < 0) {
+                    return false;
+                }
+            }
+
+            uint16_t offsets[MAX_CODE_BITS + 2] = {};
+            for (unsigned len = 1; len <= MAX_CODE_BITS; ++len) {
+                offsets[len + 1] = offsets[len] + counts[len];
+            }
+            for (unsigned i = 0; i < n; ++i) {
+                if (lengths[i]) {
+                    symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+                }
+            }
+
+            // Codes are sent most significant bit first, so table slots use the reversed code
+            unsigned code = 0;
+            unsigned index = 0;
+            for (unsigned len = 1; len <= FAST_BITS; ++len) {
+                for (unsigned k = 0; k < counts[len]; ++k, ++code) {
+                    unsigned reversed = 0;
+                    for (unsigned bit = 0; bit < len; ++bit) {
+                        reversed |= ((code >> bit) & 1) << (len - 1 - bit);
+                    }
+                    uint16_t entry = static_cast<uint16_t>((symbols[index++] << 4) | len);
+                    for (unsigned slot = reversed; slot < (1u << FAST_BITS); slot += 1u << len) {
+                        fast[slot] = entry;
+                    }
+                }
+                code <<= 1;
+            }
+            return true;
+        }
+
+        // The caller refills first; returns -1 for a code outside the set
+        int decode(BitReader& in) const {
+            uint16_t entry = fast[in.peek(FAST_BITS)];
+            if (entry) {
+                in.consume(entry & 15);
+                return entry >> 4;
+            }
+
+            uint32_t bits = in.peek(MAX_CODE_BITS);
+            int code = 0;
+            int first = 0;
+            int index = 0;
+            for (unsigned len = 1; len <= MAX_CODE_BITS; ++len) {
+                code |= bits & 1;
+                bits >>= 1;
+                int count = counts[len];
+                if (code - first < count) {
+                    in.consume(len);
+                    return symbols[index + code - first];
+                }
+                index += count;
+                first = (first + count) << 1;
+                code <<= 1;
+            }
+            return -1;
+        }
+
+    private:
+        uint16_t fast[1u << FAST_BITS];  // (symbol << 4) | length, 0 when the code is longer
+        uint16_t counts[MAX_CODE_BITS + 1];
+        uint16_t symbols[288];
+    };
+
+    // Inflates into a growing buffer that doubles as the history window
+    class Inflater {
+    public:
+        Inflater(BitReader& in, std::vector<char>& output, size_t position)
+            : in(in), output(output), position(position), start(position) {}
+
+        bool run(std::string& error) {
+            bool last;
+            do {
+                last = in.take(1) != 0;
+                uint32_t type = in.take(2);
+
+                bool ok;
+                if (type == 0) {
+                    ok = stored(error);
+                }
+                else if (type == 1) {
+                    ok = codes(fixedTables().first, fixedTables().second, error);
+                }
+                else if (type == 2) {
+                    ok = dynamic(error);
+                }
+                else {
+                    error = "invalid deflate block type";
+                    ok = false;
+                }
+                if (!ok) {
+                    return false;
+                }
+                if (in.overrun()) {
+                    error = "compressed data is truncated";
+                    return false;
+                }
+            } while (!last);
+            return true;
+        }
+
+        size_t end() const { return position; }
+
+    private:
+        BitReader& in;
+        std::vector<char>& output;
+        size_t position;
+        size_t start;  // Back-references may not reach into an earlier gzip member
+
+        char* reserve(size_t n) {
+            if (output.size() - position < n) {
+                output.resize(std::max(output.size() * 2, position + n));
+            }
+            return output.data() + position;
+        }
+
+        static const std::pair<Huffman, Huffman>& fixedTables() {
+            static const std::pair<Huffman, Huffman> tables = [] {
+                std::pair<Huffman, Huffman> t;
+                uint8_t lengths[288];
+                std::fill(lengths, lengths + 144, 8);
+                std::fill(lengths + 144, lengths + 256, 9);
+                std::fill(lengths + 256, lengths + 280, 7);
+                std::fill(lengths + 280, lengths + 288, 8);
+                t.first.build(lengths, 288);
+                std::fill(lengths, lengths + 30, 5);
+                t.second.build(lengths, 30);
+                return t;
+            }();
+            return tables;
+        }
+
+        bool stored(std::string& error) {
+            if (in.overrun()) {
+                error = "compressed data is truncated";
+                return false;
+            }
+            const unsigned char* p = in.alignToByte();
+            if (in.limit() - p < 4) {
+                error = "compressed data is truncated";
+                return false;
+            }
+            uint32_t length = read16(p);
+            if ((length ^ 0xFFFF) != read16(p + 2)) {
+                error = "stored block length check failed";
+                return false;
+            }
+            p += 4;
+            if (static_cast<size_t>(in.limit() - p) < length) {
+                error = "compressed data is truncated";
+                return false;
+            }
+            std::memcpy(reserve(length), p, length);
+            position += length;
+            in.seek(p + length);
+            return true;
+        }
+
+        bool dynamic(std::string& error) {
+            unsigned literalCount = in.take(5) + 257;
+            unsigned distanceCount = in.take(5) + 1;
+            unsigned codeLengthCount = in.take(4) + 4;
+            if (literalCount > 286 || distanceCount > 30) {
+                error = "invalid dynamic block header";
+                return false;
+            }
+
+            uint8_t lengths[286 + 30] = {};
+            for (unsigned i = 0; i < codeLengthCount; ++i) {
+                lengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(in.take(3));
+            }
+            Huffman lengthCode;
+            if (!lengthCode.build(lengths, 19)) {
+                error = "invalid code length code";
+                return false;
+            }
+
+            std::fill(lengths, lengths + 19, 0);
+            unsigned total = literalCount + distanceCount;
+            unsigned index = 0;
+            while (index < total) {
+                in.refill();
+                int symbol = lengthCode.decode(in);
+                if (symbol < 0 || in.overrun()) {
+                    error = "invalid code lengths";
+                    return false;
+                }
+                if (symbol < 16) {
+                    lengths[index++] = static_cast<uint8_t>(symbol);
+                    continue;
+                }
+
+                uint8_t repeated = 0;
+                unsigned times;
+                if (symbol == 16) {
+                    if (index == 0) {
+                        error = "code length repeat with no previous length";
+                        return false;
+                    }
+                    repeated = lengths[index - 1];
+                    times = 3 + in.take(2);
+                }
+                else if (symbol == 17) {
+                    times = 3 + in.take(3);
+                }
+                else {
+                    times = 11 + in.take(7);
+                }
+                if (index + times > total) {
+                    error = "code lengths overflow the alphabet";
+                    return false;
+                }
+                std::fill(lengths + index, lengths + index + times, repeated);
+                index += times;
+            }
+
+            if (lengths[256] == 0) {
+                error = "block has no end-of-block code";
+                return false;
+            }
+            Huffman literals;
+            Huffman distances;
+            if (!literals.build(lengths, literalCount) || !distances.build(lengths + literalCount, distanceCount)) {
+                error = "invalid literal or distance code";
+                return false;
+            }
+            return codes(literals, distances, error);
+        }
+
+        bool codes(const Huffman& literals, const Huffman& distances, std::string& error) {
+            for (;;) {
+                // 56 bits cover the longest length/distance pair (15 + 5 + 15 + 13)
+                in.refill();
+                if (in.overrun()) {
+                    error = "compressed data is truncated";
+                    return false;
+                }
+
+                int symbol = literals.decode(in);
+                if (symbol < 256) {
+                    if (symbol < 0) {
+                        error = "invalid literal/length code";
+                        return false;
+                    }
+                    *reserve(1) = static_cast<char>(symbol);
+                    ++position;
+                    continue;
+                }
+                if (symbol == 256) {
+                    return true;
+                }
+
+                symbol -= 257;
+                if (symbol >= 29) {
+                    error = "invalid length code";
+                    return false;
+                }
+                size_t length = LENGTH_BASE[symbol] + in.take(LENGTH_EXTRA[symbol]);
+
+                int code = distances.decode(in);
+                if (code < 0 || code >= 30) {
+                    error = "invalid distance code";
+                    return false;
+                }
+                size_t distance = DISTANCE_BASE[code] + in.take(DISTANCE_EXTRA[code]);
+                if (distance > position - start) {
+                    error = "distance reaches before the start of the data";
+                    return false;
+                }
+
+                char* target = reserve(length);
+                const char* source = target - distance;
+                if (distance >= length) {
+                    std::memcpy(target, source, length);
+                }
+                else {
+                    // Overlapping copy repeats the last `distance` bytes
+                    for (size_t i = 0; i < length; ++i) {
+                        target[i] = source[i];
+                    }
+                }
+                position += length;
+            }
+        }
+    };
+
+    // gzip member header flags (RFC 1952)
+    constexpr unsigned char FLAG_HCRC = 0x02;
+    constexpr unsigned char FLAG_EXTRA = 0x04;
+    constexpr unsigned char FLAG_NAME = 0x08;
+    constexpr unsigned char FLAG_COMMENT = 0x10;
+    constexpr unsigned char FLAG_RESERVED = 0xE0;
+
+    // Leaves `p` at the start of the deflate data
+    bool skipGzipHeader(const unsigned char*& p, const unsigned char* end, std::string& error) {
+        if (end - p < 10 || p[0] != 0x1F || p[1] != 0x8B) {
+            error = "not a gzip stream";
+            return false;
+        }
+        if (p[2] != 8) {
+            error = "unsupported gzip compression method";
+            return false;
+        }
+        unsigned char flags = p[3];
+        if (flags & FLAG_RESERVED) {
+            error = "reserved gzip flags set";
+            return false;
+        }
+        p += 10;
+
+        if (flags & FLAG_EXTRA) {
+            if (end - p < 2 || static_cast<size_t>(end - p - 2) < read16(p)) {
+                error = "gzip header is truncated";
+                return false;
+            }
+            p += 2 + read16(p);
+        }
+        for (unsigned char flag : { FLAG_NAME, FLAG_COMMENT }) {
+            if (flags & flag) {
+                p = std::find(p, end, '\0');
+                if (p == end) {
+                    error = "gzip header is truncated";
+                    return false;
+                }
+                ++p;
+            }
+        }
+        if (flags & FLAG_HCRC) {
+            p += 2;
+        }
+        if (p > end) {
+            error = "gzip header is truncated";
+            return false;
+        }
+        return true;
+    }
+}
+
+namespace Core {
+    namespace Compression {
+        Format detect(std::string_view data) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+            if (data.size() >= 2 && p[0] == 0x1F && p[1] == 0x8B) {
+                return Format::Gzip;
+            }
+            if (data.size() >= 4 && read32(p) == 0xFD2FB528u) {
+                return Format::Zstd;
+            }
+            return Format::None;
+        }
+
+        bool matchesExtension(std::string_view path, std::string_view extension) {
+            auto endsWith = [](std::string_view text, std::string_view suffix) {
+                return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+            };
+            if (endsWith(path, extension)) {
+                return true;
+            }
+            for (std::string_view suffix : COMPRESSED_SUFFIXES) {
+                if (endsWith(path, suffix) && endsWith(path.substr(0, path.size() - suffix.size()), extension)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool hasCompressedSuffix(std::string_view path) {
+            return std::any_of(std::begin(COMPRESSED_SUFFIXES), std::end(COMPRESSED_SUFFIXES), [&](std::string_view suffix) {
+                return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+            });
+        }
+
+        bool gunzip(std::string_view input, std::vector<char>& output, std::string& error) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(input.data());
+            const unsigned char* end = p + input.size();
+
+            // The trailer's ISIZE is only checked once a member is inflated, never used to size
+            // the buffer, so a crafted trailer cannot force a large allocation. Text inputs
+            // inflate to several times their size; the buffer doubles from there as needed.
+            output.clear();
+            output.resize(input.size() * INITIAL_EXPANSION);
+
+            size_t position = 0;
+            do {
+                if (!skipGzipHeader(p, end, error)) {
+                    return false;
+                }
+
+                size_t memberStart = position;
+                BitReader in(p, end);
+                Inflater inflater(in, output, position);
+                if (!inflater.run(error)) {
+                    return false;
+                }
+                position = inflater.end();
+
+                p = in.alignToByte();
+                if (end - p < 8) {
+                    error = "gzip trailer is truncated";
+                    return false;
+                }
+                if (crc32(output.data() + memberStart, position - memberStart) != read32(p)) {
+                    error = "gzip CRC-32 mismatch";
+                    return false;
+                }
+                if (static_cast<uint32_t>(position - memberStart) != read32(p + 4)) {
+                    error = "gzip length mismatch";
+                    return false;
+                }
+                p += 8;
+
+                // Some writers pad the file with zeros after the last member
+                if (std::all_of(p, end, [](unsigned char c) { return c == 0; })) {
+                    break;
+                }
+            } while (true);
+
+            output.resize(position);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core {
+    // Compressed inputs ("tops.json.gz", "mp_m_freemode_01.meta.gz") are recognised by
+    // suffix when scanning and by magic number when opened, and inflated in memory.
+    namespace Compression {
+        enum class Format {
+            None,
+            Gzip,
+            Zstd  // Recognised so it can be reported; there is no decoder for it
+        };
+
+        Format detect(std::string_view data);
+
+        // True for `extension` itself or followed by a compression suffix
+        bool matchesExtension(std::string_view path, std::string_view extension);
+        bool hasCompressedSuffix(std::string_view path);
+
+        // Decodes a whole gzip file (concatenated members included) into `output`,
+        // checking each member's CRC-32 and length. The buffer grows with the inflated
+        // data; the length in the (untrusted) trailer is only compared against it.
+        bool gunzip(std::string_view input, std::vector<char>& output, std::string& error);
+    }
+}
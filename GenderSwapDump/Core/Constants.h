@@ -1,6 +1,12 @@
 #pragma once
+#include "Hash.h"
+#include <string>
 #include <string_view>
 #include <vector>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <utility>
 
 namespace Core {
     // File System Constants
@@ -17,6 +23,9 @@ namespace Core {
         constexpr std::string_view NOT_IN_STORES = "[NOT IN STORES]";
         constexpr std::string_view UNKNOWN_NAME = "[NO/ UNKNOWN NAME]";
         constexpr std::string_view UNKNOWN_COMPONENT = "[UNKNOWN]";
+        constexpr int32_t INVALID_ID = -1;  // Drawable/texture/prop index that is missing or unparsable
+        constexpr std::string_view NO_LABEL = "NO_LABEL";  // GXT of a JSON row without a text label
+        constexpr std::string_view NULL_NAME = "NULL";     // Localized name of such a row
     }
 
     // Gender Identifiers
@@ -38,6 +47,23 @@ namespace Core {
         constexpr std::string_view MP_APPAREL_DATA = "MPApparelData";
         constexpr std::string_view PED_NAME = "pedName";
         constexpr std::string_view DLC_NAME = "dlcName";
+        constexpr std::string_view FULL_DLC_NAME = "fullDlcName";
+        constexpr std::string_view LOCK_HASH = "lockHash";
+        constexpr std::string_view LOCAL_DRAWABLE_INDEX = "localDrawableIndex";
+        constexpr std::string_view PROP_INDEX = "propIndex";
+        constexpr std::string_view TEXTURE_INDEX = "textureIndex";
+        constexpr std::string_view COMP_TYPE = "eCompType";
+        constexpr std::string_view ANCHOR_POINT = "eAnchorPoint";
+        constexpr std::string_view INCLUDED_COMPONENTS = "includedPedComponents";
+        constexpr std::string_view INCLUDED_PROPS = "includedPedProps";
+        constexpr std::string_view NAME_HASH = "nameHash";
+        constexpr std::string_view COST = "cost";
+        constexpr std::string_view DRAWABLE_INDEX = "drawableIndex";
+        constexpr std::string_view SHOP_ENUM = "eShopEnum";
+        constexpr std::string_view RESTRICTION_TAGS = "restrictionTags";
+        constexpr std::string_view FORCED_COMPONENTS = "forcedComponents";
+        constexpr std::string_view VARIANT_COMPONENTS = "variantComponents";
+        constexpr std::string_view TAG_NAME_HASH = "tagNameHash";
     }
 
     // JSON Field Names
@@ -78,7 +104,7 @@ namespace Core {
             std::string_view jsonPattern;       // Pattern to match in JSON filenames
         };
         
-        const std::vector<UnifiedComponentMapping> UNIFIED_COMPONENTS = {
+        inline constexpr UnifiedComponentMapping UNIFIED_COMPONENTS[] = {
             {"PV_COMP_HEAD", "HEAD",  "HAT",      "Hat",         "PHEAD",   "hats"},
             {"PV_COMP_BERD", "BERD",  "MASK",     "Mask",        "BERD",    "mask"},
             {"PV_COMP_EYES", "EYES",  "GLASSES",  "Glasses",     "PEYES",   "glasses"},
@@ -95,6 +121,47 @@ namespace Core {
             {"",             "OUTFIT","OUTFIT",   "Outfit",      "OUTFIT",  ""},
             {"",             "SPECIAL","UNKNOWN", "Unknown",     "SPECIAL", ""}
         };
+
+        // The model carries component types as IDs: row i of UNIFIED_COMPONENTS is ID i.
+        // Types outside the table (an eCompType with no mapping) are numbered after it at
+        // run time, starting with the two below; see ModelIds.h.
+        using ComponentId = uint16_t;
+        inline constexpr ComponentId COMPONENT_COUNT = static_cast<ComponentId>(std::size(UNIFIED_COMPONENTS));
+        inline constexpr ComponentId NO_COMPONENT = COMPONENT_COUNT;         // "": details never given a type
+        inline constexpr ComponentId UNSET_COMPONENT = COMPONENT_COUNT + 1;  // Defaults::UNKNOWN_COMPONENT
+
+        constexpr ComponentId componentId(const UnifiedComponentMapping& mapping) {
+            return static_cast<ComponentId>(&mapping - UNIFIED_COMPONENTS);
+        }
+
+        // Row with this internalType, or NO_COMPONENT
+        constexpr ComponentId componentId(std::string_view internalType) {
+            for (ComponentId id = 0; id < COMPONENT_COUNT; ++id) {
+                if (UNIFIED_COMPONENTS[id].internalType == internalType) {
+                    return id;
+                }
+            }
+            return NO_COMPONENT;
+        }
+
+        // JSON file name patterns in priority order, with the short component type each
+        // stands for. These predate UNIFIED_COMPONENTS' jsonPattern column and disagree with
+        // it ("accessories" is ACCS here), so they are kept as they were.
+        inline constexpr std::pair<std::string_view, std::string_view> FILE_NAME_COMPONENTS[] = {
+            {"accessories", "ACCS"},
+            {"hair", "HAIR"},
+            {"legs", "LEGS"},
+            {"shoes", "FEET"},
+            {"tops", "JBIB"},         // Torso 2
+            {"torsos", "TORSO"},      // Gloves/Arms
+            {"undershirts", "ACCS"},  // Torso 1
+            {"bracelets", "WRIST"},
+            {"ears", "TEETH"},        // Accessories
+            {"glasses", "PEYES"},
+            {"hats", "PHEAD"},
+            {"watch", "WRIST"},
+            {"mask", "BERD"},
+        };
     }
     
     // Prop Anchor Points
@@ -123,7 +190,7 @@ namespace Core {
             std::string_view dlcFileName;
         };
 
-        const std::vector<DlcMapping> DLC_LIST = {
+        inline constexpr DlcMapping DLC_LIST[] = {
             {"Beach Bum Update", "DLC_MP_BEACH", "mpbeach"},
             {"Holiday Gifts DLC", "DLC_MP_XMAS", "mpchristmas"},
             {"Valentine's Day Massacre Special DLC", "DLC_MP_VAL", "mpvalentines"},
@@ -185,6 +252,82 @@ namespace Core {
             {"Winter 2024", "DLC_MP_X24", "mp2024_02"},
             {"Winter 2024 G9EC", "DLC_MP_X24_G9EC", "mp2024_02_g9ec"}
         };
+
+        // The model carries DLCs as IDs: a DLC is the first DLC_LIST row with its display
+        // name, so the rows listing a second key (DLC_MP_BUS2, MP_DLC_LUXE) share the ID of
+        // the first. Names outside the list (an unresolved <dlcName>) are numbered after it
+        // at run time, starting with the two below; see ModelIds.h.
+        using DlcId = uint16_t;
+        inline constexpr DlcId DLC_COUNT = static_cast<DlcId>(std::size(DLC_LIST));
+        inline constexpr DlcId NO_DLC = DLC_COUNT;         // "": details never given a DLC
+        inline constexpr DlcId UNSET_DLC = DLC_COUNT + 1;  // Defaults::NA
+
+        // First row with this display name, or NO_DLC
+        constexpr DlcId dlcId(std::string_view name) {
+            for (DlcId id = 0; id < DLC_COUNT; ++id) {
+                if (DLC_LIST[id].name == name) {
+                    return id;
+                }
+            }
+            return NO_DLC;
+        }
+
+        constexpr DlcId dlcId(const DlcMapping& dlc) {
+            return dlcId(dlc.name);
+        }
+
+        // Shop meta names that differ from the DLC's dlcFileName beyond the "mp" prefix
+        inline constexpr std::pair<std::string_view, std::string_view> SHOP_META_ALIASES[] = {
+            {"impexp", "mpimportexport"},
+        };
+    }
+
+    // Fingerprint of the tables that turn input names into component types and DLCs. A
+    // cache of results derived through them keeps it and is dropped when it changes.
+    namespace Tables {
+        // Length first, so text moving between neighbouring fields still changes the hash
+        constexpr uint64_t addText(uint64_t hash, std::string_view text) {
+            return Hash::fnv1a64(text, Hash::combine(hash, text.size()));
+        }
+
+        constexpr uint64_t addRow(uint64_t hash, const ComponentTypes::UnifiedComponentMapping& row) {
+            for (std::string_view field : { row.xmlType, row.shortType, row.internalType, row.displayName,
+                                            row.legacyInFiles, row.jsonPattern }) {
+                hash = addText(hash, field);
+            }
+            return hash;
+        }
+
+        constexpr uint64_t addRow(uint64_t hash, const DlcInfo::DlcMapping& row) {
+            return addText(addText(addText(hash, row.name), row.dlc_key), row.dlcFileName);
+        }
+
+        constexpr uint64_t addRow(uint64_t hash, const std::pair<std::string_view, std::string_view>& row) {
+            return addText(addText(hash, row.first), row.second);
+        }
+
+        template <typename Table>
+        constexpr uint64_t addTable(uint64_t hash, const Table& table) {
+            hash = Hash::combine(hash, std::size(table));
+            for (const auto& row : table) {
+                hash = addRow(hash, row);
+            }
+            return hash;
+        }
+
+        template <typename Components, typename FileNames, typename Dlcs, typename Aliases>
+        constexpr uint64_t fingerprint(const Components& components, const FileNames& fileNames,
+                                       const Dlcs& dlcs, const Aliases& aliases) {
+            uint64_t hash = Hash::FNV_OFFSET_BASIS;
+            hash = addTable(hash, components);
+            hash = addTable(hash, fileNames);
+            hash = addTable(hash, dlcs);
+            return addTable(hash, aliases);
+        }
+
+        inline constexpr uint64_t FINGERPRINT = fingerprint(ComponentTypes::UNIFIED_COMPONENTS,
+                                                            ComponentTypes::FILE_NAME_COMPONENTS,
+                                                            DlcInfo::DLC_LIST, DlcInfo::SHOP_META_ALIASES);
     }
 
     // File Extensions
@@ -196,6 +339,34 @@ namespace Core {
 
     // Helper functions for component type lookups
     namespace ComponentUtils {
+        // Parse a drawable/texture/prop index once at ingest. Accepts what std::stoi did
+        // (leading whitespace, optional sign, trailing junk ignored) without throwing.
+        // Empty text yields INVALID_ID and counts as success; anything else that is not
+        // a number in int32_t range yields INVALID_ID and returns false.
+        inline bool parseId(std::string_view text, int32_t& out) {
+            out = Defaults::INVALID_ID;
+
+            size_t start = text.find_first_not_of(" \t\r\n\f\v");
+            if (start == std::string_view::npos) {
+                return text.empty();
+            }
+            text.remove_prefix(start);
+            if (text.front() == '+') {
+                text.remove_prefix(1);
+                if (!text.empty() && text.front() == '-') {
+                    return false;
+                }
+            }
+
+            int32_t value = 0;
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc()) {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+
         // Find unified component mapping by any field
         inline const ComponentTypes::UnifiedComponentMapping* findUnifiedComponent(std::string_view type) {
             for (const auto& mapping : ComponentTypes::UNIFIED_COMPONENTS) {
@@ -275,58 +446,21 @@ namespace Core {
             return findAnchor(anchorPoint) != nullptr;
         }
         
+        // The DLC whose dlc_key is the longest one occurring in `text` (an item key or
+        // uniqueNameHash), or nullptr; see DlcKeyMatcher
+        const DlcInfo::DlcMapping* matchDlcKey(std::string_view text);
+
         // Extract DLC key from uniqueNameHash
         inline std::string extractDlcFromHash(std::string_view uniqueNameHash) {
-            // Look for DLC_MP_ pattern in the hash
-            size_t dlcPos = uniqueNameHash.find("DLC_MP_");
-            if (dlcPos != std::string_view::npos) {
-                // Find the next underscore after DLC_MP_XXX to get the complete DLC key
-                size_t startPos = dlcPos;
-                size_t endPos = uniqueNameHash.find('_', startPos + 7); // Skip "DLC_MP_"
-                
-                // Look for pattern like DLC_MP_XXX_[M|F]_ or DLC_MP_XXX_G9EC_
-                if (endPos != std::string_view::npos) {
-                    // Check if next part is gender (M/F) or platform specific (G9EC)
-                    std::string_view nextPart = uniqueNameHash.substr(endPos + 1, 1);
-                    if (nextPart == "M" || nextPart == "F") {
-                        // Standard pattern: DLC_MP_XXX_M_ or DLC_MP_XXX_F_
-                        return std::string(uniqueNameHash.substr(startPos, endPos - startPos));
-                    } else {
-                        // Could be G9EC or other platform specific
-                        size_t secondEndPos = uniqueNameHash.find('_', endPos + 1);
-                        if (secondEndPos != std::string_view::npos) {
-                            std::string_view platformPart = uniqueNameHash.substr(endPos + 1, secondEndPos - endPos - 1);
-                            if (platformPart == "G9EC") {
-                                // Platform specific: DLC_MP_XXX_G9EC
-                                return std::string(uniqueNameHash.substr(startPos, secondEndPos - startPos));
-                            } else {
-                                // Regular DLC with extra part: DLC_MP_XXX_PART
-                                return std::string(uniqueNameHash.substr(startPos, endPos - startPos));
-                            }
-                        } else {
-                            // No more underscores, take up to this point
-                            return std::string(uniqueNameHash.substr(startPos, endPos - startPos));
-                        }
-                    }
-                } else {
-                    // No underscore found after DLC_MP_, unlikely but handle gracefully
-                    return std::string(uniqueNameHash.substr(startPos));
-                }
-            }
-            
-            // No DLC pattern found, return empty string
-            return "";
+            const DlcInfo::DlcMapping* dlc = matchDlcKey(uniqueNameHash);
+            return dlc ? std::string(dlc->dlc_key) : std::string();
         }
         
         // Resolve DLC name from uniqueNameHash first, then fallback to input patterns
         inline std::string resolveDlcFromHash(std::string_view uniqueNameHash, std::string_view fallbackInput = "") {
             // First try to extract DLC from hash
-            std::string dlcKey = extractDlcFromHash(uniqueNameHash);
-            if (!dlcKey.empty()) {
-                auto* dlc = findDlcMapping(dlcKey);
-                if (dlc) {
-                    return std::string(dlc->name);
-                }
+            if (auto* dlc = matchDlcKey(uniqueNameHash)) {
+                return std::string(dlc->name);
             }
             
             // Fallback to regular resolution if provided
@@ -0,0 +1,96 @@
+#include "DlcKeyMatcher.h"
+#include <algorithm>
+#include <iterator>
+#include <queue>
+
+namespace Core {
+    namespace ComponentUtils {
+        const DlcInfo::DlcMapping* matchDlcKey(std::string_view text) {
+            return DlcKeyMatcher::instance().match(text);
+        }
+    }
+
+    int DlcKeyMatcher::byteClass(unsigned char c) {
+        if (c >= 'A' && c <= 'Z') return 1 + (c - 'A');
+        if (c >= '0' && c <= '9') return 27 + (c - '0');
+        if (c == '_') return 37;
+        return 0;
+    }
+
+    DlcKeyMatcher::DlcKeyMatcher() {
+        const auto& dlcs = DlcInfo::DLC_LIST;
+        // Trie of the keys; -1 marks a missing edge until the fail links fill it in
+        State root;
+        std::fill(std::begin(root.next), std::end(root.next), -1);
+        states.push_back(root);
+        for (size_t i = 0; i < std::size(dlcs); ++i) {
+            int32_t state = 0;
+            for (unsigned char c : dlcs[i].dlc_key) {
+                int cls = byteClass(c);
+                if (states[state].next[cls] < 0) {
+                    states[state].next[cls] = static_cast<int32_t>(states.size());
+                    states.push_back(root);
+                }
+                state = states[state].next[cls];
+            }
+            int32_t& output = states[state].output;
+            if (output == NO_PATTERN) {
+                output = static_cast<int32_t>(i);  // A repeated key keeps its first entry
+            }
+        }
+
+        // Breadth first, so a state's fail target is complete before the state is.
+        // The "other" class never matches a key byte; its edge always returns to the root.
+        std::queue<int32_t> pending;
+        for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+            int32_t& next = states[0].next[cls];
+            if (next < 0 || cls == 0) {
+                next = 0;
+            }
+            else {
+                states[next].fail = 0;
+                pending.push(next);
+            }
+        }
+        while (!pending.empty()) {
+            int32_t state = pending.front();
+            pending.pop();
+            // A key ending here is longer than any key ending at the fail target
+            if (states[state].output == NO_PATTERN) {
+                states[state].output = states[states[state].fail].output;
+            }
+            for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+                int32_t next = states[state].next[cls];
+                int32_t fallback = states[states[state].fail].next[cls];
+                if (next < 0) {
+                    states[state].next[cls] = fallback;
+                }
+                else {
+                    states[next].fail = fallback;
+                    pending.push(next);
+                }
+            }
+        }
+    }
+
+    const DlcKeyMatcher& DlcKeyMatcher::instance() {
+        static const DlcKeyMatcher matcher;
+        return matcher;
+    }
+
+    const DlcInfo::DlcMapping* DlcKeyMatcher::match(std::string_view text) const {
+        const auto& dlcs = DlcInfo::DLC_LIST;
+        int32_t state = 0;
+        int32_t best = NO_PATTERN;
+        size_t bestLength = 0;
+        for (unsigned char c : text) {
+            state = states[state].next[byteClass(c)];
+            int32_t output = states[state].output;
+            if (output != NO_PATTERN && dlcs[output].dlc_key.size() > bestLength) {
+                best = output;
+                bestLength = dlcs[output].dlc_key.size();
+            }
+        }
+        return best == NO_PATTERN ? nullptr : &dlcs[best];
+    }
+}
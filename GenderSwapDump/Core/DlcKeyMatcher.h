@@ -0,0 +1,38 @@
+#pragma once
+#include "Constants.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Core {
+    // Aho-Corasick automaton over every dlc_key in DLC_LIST, compiled once into a full
+    // transition table so a key is resolved in one pass with one table lookup per byte.
+    // The longest dlc_key occurring anywhere in the text wins (the leftmost of equally
+    // long ones), so DLC_MP_BUSI2 is not taken for DLC_MP_BUSI, nor DLC_MP_ARENA for
+    // DLC_MP_AR, whatever their order in the list.
+    class DlcKeyMatcher {
+    public:
+        DlcKeyMatcher();
+
+        // The automaton for DLC_LIST
+        static const DlcKeyMatcher& instance();
+
+        const DlcInfo::DlcMapping* match(std::string_view text) const;
+
+    private:
+        // dlc_keys are upper case letters, digits and '_'; every other byte is one class
+        // that always leads back to the root
+        static constexpr int CLASS_COUNT = 26 + 10 + 1 + 1;
+        static constexpr int32_t NO_PATTERN = -1;
+
+        struct State {
+            int32_t next[CLASS_COUNT];
+            int32_t fail{0};
+            int32_t output{NO_PATTERN};  // Longest dlc_key ending here, through the fail links
+        };
+
+        std::vector<State> states;
+
+        static int byteClass(unsigned char c);
+    };
+}
@@ -0,0 +1,44 @@
+#include "DlcSelection.h"
+#include <algorithm>
+
+namespace Core {
+    bool DlcSelection::add(std::string_view dlc) {
+        const DlcInfo::DlcMapping* match = ComponentUtils::findDlcMapping(dlc);
+        if (!match) {
+            return false;
+        }
+        for (const auto& mapping : DlcInfo::DLC_LIST) {
+            if (mapping.name == match->name && std::find(entries.begin(), entries.end(), &mapping) == entries.end()) {
+                entries.push_back(&mapping);
+            }
+        }
+        return true;
+    }
+
+    bool DlcSelection::containsName(std::string_view name) const {
+        return std::any_of(entries.begin(), entries.end(),
+                           [&](const DlcInfo::DlcMapping* mapping) { return mapping->name == name; });
+    }
+
+    bool DlcSelection::contains(DlcInfo::DlcId id) const {
+        return std::any_of(entries.begin(), entries.end(),
+                           [&](const DlcInfo::DlcMapping* mapping) { return DlcInfo::dlcId(*mapping) == id; });
+    }
+
+    bool DlcSelection::mentionedIn(std::string_view text) const {
+        return std::any_of(entries.begin(), entries.end(),
+                           [&](const DlcInfo::DlcMapping* mapping) { return text.find(mapping->dlc_key) != std::string_view::npos; });
+    }
+
+    std::string DlcSelection::describe() const {
+        std::string names;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            bool repeated = std::any_of(entries.begin(), entries.begin() + i,
+                                        [&](const DlcInfo::DlcMapping* earlier) { return earlier->name == entries[i]->name; });
+            if (!repeated) {
+                names += (names.empty() ? "" : ", ") + std::string(entries[i]->name);
+            }
+        }
+        return names;
+    }
+}
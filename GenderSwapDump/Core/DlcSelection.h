@@ -0,0 +1,42 @@
+#pragma once
+#include "Constants.h"
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace Core {
+    // DLCs chosen on the command line. A DLC is named by any of its DLC_LIST fields
+    // (dlc_key, dlcFileName or display name) and selecting it selects every entry that
+    // shares its display name, e.g. both keys of Business Update 2.
+    //
+    // Items of other DLCs still matter when they share a text label with a selected item
+    // (JSON enrichment goes to the first item with the label), so the XmlParser also
+    // loads the shop meta files sharing those labels and records every item key it
+    // loaded as related; script metadata keeps the items with related keys.
+    class DlcSelection {
+    public:
+        // False if `dlc` names no DLC_LIST entry
+        bool add(std::string_view dlc);
+
+        bool empty() const { return entries.empty(); }
+        const std::vector<const DlcInfo::DlcMapping*>& mappings() const { return entries; }
+
+        bool containsName(std::string_view name) const;
+        bool contains(DlcInfo::DlcId id) const;
+
+        // Whether any selected dlc_key occurs in `text`: a shop meta file's contents, an item key
+        bool mentionedIn(std::string_view text) const;
+
+        void addRelatedKey(std::string_view key) { relatedKeys.emplace(key); }
+        bool isRelatedKey(std::string_view key) const { return relatedKeys.count(std::string(key)) > 0; }
+        size_t relatedKeyCount() const { return relatedKeys.size(); }
+
+        // Comma-separated display names, for the log
+        std::string describe() const;
+
+    private:
+        std::vector<const DlcInfo::DlcMapping*> entries;
+        std::unordered_set<std::string> relatedKeys;
+    };
+}
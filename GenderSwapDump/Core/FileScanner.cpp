@@ -0,0 +1,107 @@
+#include "FileScanner.h"
+#include "ComponentClassifier.h"
+#include "Compression.h"
+#include "InputFile.h"
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+
+namespace Core {
+    namespace {
+        bool contains(std::string_view text, std::string_view part) {
+            return text.find(part) != std::string_view::npos;
+        }
+
+        const DlcInfo::DlcMapping* shopMetaDlc(std::string_view name) {
+            constexpr std::string_view FREEMODE = "_freemode_01_";
+            constexpr std::string_view SHOP = "_shop.meta";
+            size_t start = name.find(FREEMODE);
+            if (start == std::string_view::npos || name.size() < start + FREEMODE.size() + SHOP.size() ||
+                name.substr(name.size() - SHOP.size()) != SHOP) {
+                return nullptr;
+            }
+            start += FREEMODE.size();
+            std::string_view dlc = name.substr(start, name.size() - SHOP.size() - start);
+
+            for (const auto& alias : DlcInfo::SHOP_META_ALIASES) {
+                if (alias.first == dlc) {
+                    return ComponentUtils::findDlcMapping(alias.second);
+                }
+            }
+            if (const auto* mapping = ComponentUtils::findDlcMapping(dlc)) {
+                return mapping;
+            }
+            return ComponentUtils::findDlcMapping("mp" + std::string(dlc));
+        }
+    }
+
+    InputGender inputGender(std::string_view path) {
+        std::string_view name = inputFileName(path);
+        if (contains(name, "female") || contains(name, "_f_")) return InputGender::Female;
+        if (contains(name, "male") || contains(name, "_m_")) return InputGender::Male;
+        return InputGender::Unknown;
+    }
+
+    std::string_view inputComponent(std::string_view path) {
+        // Only the file name counts, so an overlay directory's name cannot change the type
+        return ComponentClassifier::instance().classifyFileName(inputFileName(path));
+    }
+
+    InputClass classifyInput(std::string_view path) {
+        InputClass kind;
+        kind.gender = inputGender(path);
+        std::string_view name = inputFileName(path);
+        if (Compression::matchesExtension(name, ".meta")) {
+            kind.dlc = shopMetaDlc(name);
+        }
+        else if (Compression::matchesExtension(name, ".json")) {
+            kind.component = inputComponent(name);
+        }
+        return kind;
+    }
+
+    bool scanInputs(const TarBundle* bundle, const std::string& directory, std::string_view extension,
+                    std::vector<ScannedFile>& files, std::string& error) {
+        if (bundle) {
+            for (auto& path : bundle->list(directory, extension)) {
+                uint64_t size = inputSize(bundle, path);
+                InputClass kind = classifyInput(path);
+                files.push_back({ std::move(path), size, kind });
+            }
+            return true;
+        }
+
+        try {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+                std::string path = entry.path().string();
+                if (!Compression::matchesExtension(path, extension)) {
+                    continue;
+                }
+                std::error_code ec;
+                uintmax_t size = entry.file_size(ec);
+                InputClass kind = classifyInput(path);
+                files.push_back({ std::move(path), ec ? 0 : static_cast<uint64_t>(size), kind });
+            }
+            return true;
+        }
+        catch (const std::filesystem::filesystem_error& e) {
+            error = std::string("Filesystem error: ") + e.what();
+            return false;
+        }
+    }
+
+    std::vector<size_t> largestFirst(const std::vector<ScannedFile>& files) {
+        std::vector<size_t> order(files.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return files[a].size > files[b].size; });
+        return order;
+    }
+
+    size_t countGender(const std::vector<ScannedFile>& files, InputGender gender) {
+        return static_cast<size_t>(std::count_if(files.begin(), files.end(),
+                                                 [&](const ScannedFile& file) { return file.kind.gender == gender; }));
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Constants.h"
+#include "TarBundle.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core {
+    enum class InputGender { Unknown, Male, Female };
+
+    // What an input's file name says about it, known before the file is opened
+    struct InputClass {
+        InputGender gender{InputGender::Unknown};
+        const DlcInfo::DlcMapping* dlc{nullptr};  // Shop meta: the <dlc> in "mp_f_freemode_01_<dlc>_shop.meta"
+        std::string_view component;               // JSON: short component type, "UNKNOWN" if no name matches
+    };
+
+    struct ScannedFile {
+        std::string path;
+        uint64_t size{0};
+        InputClass kind;
+    };
+
+    // "female" or "_f_" in the file name is female, otherwise "male" or "_m_" is male
+    InputGender inputGender(std::string_view path);
+
+    // Short component type of a JSON file, from its name ("female_tops.json" -> "JBIB")
+    std::string_view inputComponent(std::string_view path);
+
+    InputClass classifyInput(std::string_view path);
+
+    // Appends the files below `directory` with `extension` (compressed or not), sized and
+    // classified: the bundle's members in archive order when there is a bundle, otherwise
+    // the disk in iteration order. Sizes come from the member headers or directory entries,
+    // so nothing is opened.
+    bool scanInputs(const TarBundle* bundle, const std::string& directory, std::string_view extension,
+                    std::vector<ScannedFile>& files, std::string& error);
+
+    // Indices into `files`, largest first with ties in scan order: the loaders' work list
+    std::vector<size_t> largestFirst(const std::vector<ScannedFile>& files);
+
+    size_t countGender(const std::vector<ScannedFile>& files, InputGender gender);
+}
@@ -0,0 +1,32 @@
+#include "FileStamp.h"
+#include "Hash.h"
+#include "MappedFile.h"
+#include <filesystem>
+
+namespace Core {
+    bool FileStamp::read(const std::string& path, FileStamp& stamp, bool hashContents) {
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return false;
+        }
+        auto modified = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return false;
+        }
+
+        stamp.size = static_cast<uint64_t>(size);
+        stamp.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+        stamp.contentHash = 0;
+        return !hashContents || hash(path, stamp);
+    }
+
+    bool FileStamp::hash(const std::string& path, FileStamp& stamp) {
+        MappedFile file;
+        if (!file.open(path)) {
+            return false;
+        }
+        stamp.contentHash = Hash::contentHash(file.data(), file.size());
+        return true;
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace Core {
+    // Identity of an input file's contents, recorded so a later run can tell whether
+    // results derived from it are still valid
+    struct FileStamp {
+        uint64_t size{0};
+        int64_t modified{0};      // Filesystem clock ticks; only ever compared for equality
+        uint64_t contentHash{0};  // Hash::contentHash of the whole file
+
+        // Fill size and modification time, and the content hash when `hashContents` is set
+        static bool read(const std::string& path, FileStamp& stamp, bool hashContents = true);
+        static bool hash(const std::string& path, FileStamp& stamp);
+    };
+}
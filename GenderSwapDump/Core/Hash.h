@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace Core {
+    // Non-cryptographic hashes for change detection and cache checksums.
+    // FNV-1a is simple and constexpr; contentHash (XXH64) is the fast one for whole files.
+    namespace Hash {
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+        constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+        constexpr uint64_t fnv1a64(std::string_view data, uint64_t hash = FNV_OFFSET_BASIS) {
+            for (char c : data) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= FNV_PRIME;
+            }
+            return hash;
+        }
+
+        inline uint64_t fnv1a64(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS) {
+            return fnv1a64(std::string_view(static_cast<const char*>(data), size), hash);
+        }
+
+        // Mix an integer in byte by byte so the result does not depend on host endianness
+        constexpr uint64_t combine(uint64_t hash, uint64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                hash ^= (value >> (i * 8)) & 0xFF;
+                hash *= FNV_PRIME;
+            }
+            return hash;
+        }
+
+        namespace Detail {
+            constexpr uint64_t XXH_PRIME1 = 0x9E3779B185EBCA87ULL;
+            constexpr uint64_t XXH_PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+            constexpr uint64_t XXH_PRIME3 = 0x165667B19E3779F9ULL;
+            constexpr uint64_t XXH_PRIME4 = 0x85EBCA77C2B2AE63ULL;
+            constexpr uint64_t XXH_PRIME5 = 0x27D4EB2F165667C5ULL;
+
+            inline uint64_t rotl(uint64_t value, int bits) {
+                return (value << bits) | (value >> (64 - bits));
+            }
+
+            // Inputs are little-endian on every platform this tool targets
+            inline uint64_t read64(const unsigned char* p) {
+                uint64_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+
+            inline uint32_t read32(const unsigned char* p) {
+                uint32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+
+            inline uint64_t round(uint64_t acc, uint64_t input) {
+                acc += input * XXH_PRIME2;
+                return rotl(acc, 31) * XXH_PRIME1;
+            }
+
+            inline uint64_t mergeRound(uint64_t acc, uint64_t value) {
+                acc ^= round(0, value);
+                return acc * XXH_PRIME1 + XXH_PRIME4;
+            }
+        }
+
+        // XXH64 (seed 0): several GB/s, so hashing a file costs little next to parsing it
+        inline uint64_t contentHash(const void* data, size_t size) {
+            using namespace Detail;
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            const unsigned char* end = p + size;
+            uint64_t hash;
+
+            if (size >= 32) {
+                uint64_t v1 = XXH_PRIME1 + XXH_PRIME2;
+                uint64_t v2 = XXH_PRIME2;
+                uint64_t v3 = 0;
+                uint64_t v4 = 0 - XXH_PRIME1;
+                for (; end - p >= 32; p += 32) {
+                    v1 = round(v1, read64(p));
+                    v2 = round(v2, read64(p + 8));
+                    v3 = round(v3, read64(p + 16));
+                    v4 = round(v4, read64(p + 24));
+                }
+                hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+                hash = mergeRound(hash, v1);
+                hash = mergeRound(hash, v2);
+                hash = mergeRound(hash, v3);
+                hash = mergeRound(hash, v4);
+            }
+            else {
+                hash = XXH_PRIME5;
+            }
+
+            hash += static_cast<uint64_t>(size);
+            for (; end - p >= 8; p += 8) {
+                hash ^= round(0, read64(p));
+                hash = rotl(hash, 27) * XXH_PRIME1 + XXH_PRIME4;
+            }
+            if (end - p >= 4) {
+                hash ^= static_cast<uint64_t>(read32(p)) * XXH_PRIME1;
+                hash = rotl(hash, 23) * XXH_PRIME2 + XXH_PRIME3;
+                p += 4;
+            }
+            for (; p < end; ++p) {
+                hash ^= (*p) * XXH_PRIME5;
+                hash = rotl(hash, 11) * XXH_PRIME1;
+            }
+
+            hash ^= hash >> 33;
+            hash *= XXH_PRIME2;
+            hash ^= hash >> 29;
+            hash *= XXH_PRIME3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include "InputFile.h"
+#include "Compression.h"
+#include <filesystem>
+
+namespace Core {
+    bool InputFile::open(const TarBundle* bundle, const std::string& path, Access access, std::string& error) {
+        close();
+
+        if (const TarBundle::Member* member = bundle ? bundle->find(path) : nullptr) {
+            buffer = member->data;
+            length = member->size;
+        }
+        else {
+            if (!mapping.open(path, access)) {
+                error = "Failed to open " + path;
+                return false;
+            }
+            buffer = mapping.data();
+            length = mapping.size();
+        }
+
+        switch (Compression::detect(view())) {
+        case Compression::Format::Gzip:
+            // Inflated straight from the mapped bytes into the buffer the parser will read
+            if (!Compression::gunzip(view(), inflated, error)) {
+                error = path + ": " + error;
+                close();
+                return false;
+            }
+            mapping.close();
+            buffer = inflated.data();
+            length = inflated.size();
+            compressed = true;
+            break;
+        case Compression::Format::Zstd:
+            error = path + ": zstd-compressed input is not supported, recompress it with gzip";
+            close();
+            return false;
+        default:
+            break;
+        }
+
+        opened = true;
+        return true;
+    }
+
+    void InputFile::close() {
+        mapping.close();
+        std::vector<char>().swap(inflated);
+        buffer = nullptr;
+        length = 0;
+        opened = false;
+        compressed = false;
+    }
+
+    std::string resolveInputPath(const TarBundle* bundle, const std::string& path) {
+        auto exists = [bundle](const std::string& candidate) {
+            std::error_code ec;
+            return (bundle && bundle->find(candidate)) || std::filesystem::is_regular_file(candidate, ec);
+        };
+        if (exists(path)) {
+            return path;
+        }
+        for (const char* suffix : { ".gz", ".zst" }) {
+            if (exists(path + suffix)) {
+                return path + suffix;
+            }
+        }
+        return path;
+    }
+
+    std::string_view inputFileName(std::string_view path) {
+        size_t slash = path.find_last_of("/\\");
+        std::string_view name = slash == std::string_view::npos ? path : path.substr(slash + 1);
+        if (Compression::hasCompressedSuffix(name)) {
+            name = name.substr(0, name.rfind('.'));
+        }
+        return name;
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "MappedFile.h"
+#include "TarBundle.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core {
+    // The bytes of one input file wherever they come from: a bundle member, a mapping of
+    // the file on disk, or a heap buffer holding the inflated contents of a gzip file.
+    // Compression is recognised by magic number, so the caller never needs to know.
+    // In-place parsers may write into data() with CopyOnWrite access (and always into
+    // bundle members and inflated buffers); the view stays put when the object is moved.
+    class InputFile {
+    public:
+        using Access = MappedFile::Access;
+
+        bool open(const TarBundle* bundle, const std::string& path, Access access, std::string& error);
+        void close();
+
+        bool isOpen() const { return opened; }
+        bool wasCompressed() const { return compressed; }
+        char* data() { return buffer; }
+        size_t size() const { return length; }
+        std::string_view view() const { return std::string_view(buffer, length); }
+
+    private:
+        MappedFile mapping;
+        std::vector<char> inflated;
+        char* buffer{nullptr};
+        size_t length{0};
+        bool opened{false};
+        bool compressed{false};
+    };
+
+    // `path` if it exists (in the bundle or on disk), else its compressed sibling
+    // ("scriptmetadata.meta.gz"), else `path` again so the open reports it missing
+    std::string resolveInputPath(const TarBundle* bundle, const std::string& path);
+
+    // The file name in `path` without directories or a compression suffix, which is what
+    // identifies an input across roots: "mods/Jsonfiles/female_hair.json.gz" -> "female_hair.json"
+    std::string_view inputFileName(std::string_view path);
+}
@@ -17,6 +17,7 @@ namespace Core {
     }
 
     void FileLogger::log(const std::string& message) {
+        std::lock_guard<std::mutex> lock(logMutex);
         auto now = std::chrono::system_clock::now();
         auto time = std::chrono::system_clock::to_time_t(now);
         
@@ -34,6 +35,7 @@ namespace Core {
     }
 
     void FileLogger::error(const std::string& message) {
+        std::lock_guard<std::mutex> lock(logMutex);
         auto now = std::chrono::system_clock::now();
         auto time = std::chrono::system_clock::to_time_t(now);
         
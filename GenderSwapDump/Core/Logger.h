@@ -1,12 +1,14 @@
 #pragma once
 #include "Interfaces.h"
 #include <fstream>
+#include <mutex>
 
 namespace Core {
     class FileLogger : public ILogger {
     private:
         std::ofstream logFile;
         const std::string logPath;
+        std::mutex logMutex;  // Parsers may log from worker threads
 
     public:
         explicit FileLogger(const std::string& path);
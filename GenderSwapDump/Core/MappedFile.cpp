@@ -0,0 +1,141 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Core {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            buffer = std::exchange(other.buffer, nullptr);
+            length = std::exchange(other.length, 0);
+            opened = std::exchange(other.opened, false);
+#ifdef _WIN32
+            fileHandle = std::exchange(other.fileHandle, nullptr);
+            mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string& path, Access access) {
+        close();
+        const bool copyOnWrite = access == Access::CopyOnWrite;
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        // Zero-length files cannot be mapped; treat them as an open, empty view
+        if (fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            opened = true;
+            return true;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr,
+                                            copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY,
+                                            0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        fileHandle = file;
+        mappingHandle = mapping;
+        buffer = static_cast<char*>(view);
+        length = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        if (st.st_size == 0) {
+            ::close(fd);
+            opened = true;
+            return true;
+        }
+
+        int protection = copyOnWrite ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), protection, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps its own reference to the file
+        if (view == MAP_FAILED) {
+            return false;
+        }
+        madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        buffer = static_cast<char*>(view);
+        length = static_cast<size_t>(st.st_size);
+#endif
+
+        opened = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+#ifdef _WIN32
+        if (buffer) {
+            UnmapViewOfFile(buffer);
+        }
+        if (mappingHandle) {
+            CloseHandle(static_cast<HANDLE>(mappingHandle));
+        }
+        if (fileHandle) {
+            CloseHandle(static_cast<HANDLE>(fileHandle));
+        }
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        if (buffer) {
+            munmap(buffer, length);
+        }
+#endif
+        buffer = nullptr;
+        length = 0;
+        opened = false;
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace Core {
+    // RAII view of a whole file mapped into the address space.
+    // CopyOnWrite mappings are writable but private: edits never reach the file,
+    // which is what in-situ parsers need to terminate strings in place.
+    class MappedFile {
+    public:
+        enum class Access {
+            ReadOnly,
+            CopyOnWrite
+        };
+
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const std::string& path, Access access = Access::ReadOnly);
+        void close();
+
+        bool isOpen() const { return opened; }
+        char* data() { return buffer; }
+        const char* data() const { return buffer; }
+        size_t size() const { return length; }
+        std::string_view view() const { return std::string_view(buffer, length); }
+
+    private:
+        char* buffer{nullptr};
+        size_t length{0};
+        bool opened{false};
+#ifdef _WIN32
+        void* fileHandle{nullptr};
+        void* mappingHandle{nullptr};
+#endif
+    };
+}
@@ -0,0 +1,151 @@
+#include "ModelIds.h"
+#include "StringPool.h"
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Core {
+    namespace {
+        // Names outside one table, numbered from the table's size on. A table row can be
+        // named in more than one way (kinds); each kind has its own names, so an ID handed
+        // out for one kind never resolves under another. The reserved names come first and
+        // belong to every kind.
+        class ExtraNames {
+        public:
+            ExtraNames(std::initializer_list<const char*> kinds, uint16_t first,
+                       std::initializer_list<std::string_view> reserved)
+                : kinds(kinds)
+                , first(first)
+                , ids(kinds.size())
+            {
+                for (std::string_view name : reserved) {
+                    uint16_t added = add(name, ALL_KINDS);
+                    for (auto& kindIds : ids) {
+                        kindIds.emplace(names.back().text, added);
+                    }
+                }
+            }
+
+            uint16_t id(std::string_view name, size_t kind = 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = ids[kind].find(name);
+                if (it != ids[kind].end()) {
+                    return it->second;
+                }
+                uint16_t added = add(name, kind);
+                ids[kind].emplace(names.back().text, added);
+                return added;
+            }
+
+            std::string_view name(uint16_t id, size_t kind = 0) const {
+                std::lock_guard<std::mutex> lock(mutex);
+                const Entry& entry = names.at(id - first);
+                if (entry.kind != kind && entry.kind != ALL_KINDS) {
+                    throw std::out_of_range("ID " + std::to_string(id) + " is not a " + kinds[kind] + " name");
+                }
+                return entry.text;
+            }
+
+            size_t end() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return first + names.size();
+            }
+
+        private:
+            static constexpr size_t ALL_KINDS = std::numeric_limits<size_t>::max();
+
+            struct Entry {
+                std::string_view text;
+                size_t kind;
+            };
+
+            // Caller holds the mutex (or is the constructor)
+            uint16_t add(std::string_view name, size_t kind) {
+                if (first + names.size() > std::numeric_limits<uint16_t>::max()) {
+                    throw std::overflow_error(std::string("Too many distinct ") +
+                                              kinds[kind == ALL_KINDS ? 0 : kind] + " names");
+                }
+                names.push_back({ intern(name), kind });
+                return static_cast<uint16_t>(first + names.size() - 1);
+            }
+
+            const std::vector<const char*> kinds;
+            const uint16_t first;
+            mutable std::mutex mutex;
+            std::vector<Entry> names;
+            std::vector<std::unordered_map<std::string_view, uint16_t>> ids;
+        };
+
+        enum ComponentNameKind : size_t {
+            INTERNAL_TYPE,
+            DISPLAY_NAME
+        };
+
+        // NO_* and UNSET_* come first, in that order
+        ExtraNames& componentExtras() {
+            static ExtraNames extras({ "component type", "component display" }, ComponentTypes::COMPONENT_COUNT,
+                                     { "", Defaults::UNKNOWN_COMPONENT });
+            return extras;
+        }
+
+        ExtraNames& dlcExtras() {
+            static ExtraNames extras({ "DLC" }, DlcInfo::DLC_COUNT, { "", Defaults::NA });
+            return extras;
+        }
+    }
+
+    namespace ModelIds {
+        ComponentTypes::ComponentId componentOfType(std::string_view internalType) {
+            ComponentTypes::ComponentId id = ComponentTypes::componentId(internalType);
+            return id < ComponentTypes::COMPONENT_COUNT ? id : componentExtras().id(internalType, INTERNAL_TYPE);
+        }
+
+        std::string_view componentType(ComponentTypes::ComponentId id) {
+            return id < ComponentTypes::COMPONENT_COUNT ? ComponentTypes::UNIFIED_COMPONENTS[id].internalType
+                                                        : componentExtras().name(id, INTERNAL_TYPE);
+        }
+
+        ComponentTypes::ComponentId componentOfDisplayName(std::string_view displayName) {
+            for (const auto& mapping : ComponentTypes::UNIFIED_COMPONENTS) {
+                if (mapping.displayName == displayName) {
+                    return ComponentTypes::componentId(mapping);
+                }
+            }
+            return componentExtras().id(displayName, DISPLAY_NAME);
+        }
+
+        std::string_view componentDisplayName(ComponentTypes::ComponentId id) {
+            return id < ComponentTypes::COMPONENT_COUNT ? ComponentTypes::UNIFIED_COMPONENTS[id].displayName
+                                                        : componentExtras().name(id, DISPLAY_NAME);
+        }
+
+        size_t componentIdCount() {
+            return componentExtras().end();
+        }
+
+        DlcInfo::DlcId dlcOfName(std::string_view name) {
+            DlcInfo::DlcId id = DlcInfo::dlcId(name);
+            return id < DlcInfo::DLC_COUNT ? id : dlcExtras().id(name);
+        }
+
+        std::string_view dlcName(DlcInfo::DlcId id) {
+            return id < DlcInfo::DLC_COUNT ? DlcInfo::DLC_LIST[id].name : dlcExtras().name(id);
+        }
+
+        std::string dlcDisplayName(DlcInfo::DlcId id) {
+            if (id < DlcInfo::DLC_COUNT) {
+                const auto& dlc = DlcInfo::DLC_LIST[id];
+                return std::string(dlc.name) + " (" + std::string(dlc.dlcFileName) + ")";
+            }
+            return ComponentUtils::getDlcDisplayName(dlcExtras().name(id));
+        }
+
+        size_t dlcIdCount() {
+            return dlcExtras().end();
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Constants.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Core {
+    // Text behind the DLC and component IDs the model carries. IDs of DLC_LIST and
+    // UNIFIED_COMPONENTS rows are fixed at compile time (see Constants.h); any other name
+    // gets the next free ID the first time it is seen and keeps it for the rest of the
+    // run, so an ID always round-trips to the exact text it replaced. Component internalType
+    // and displayName names are kept apart: such an ID resolves only through the pair that
+    // handed it out, and asking the other pair for it throws std::out_of_range. Safe to
+    // use from the parser worker threads.
+    namespace ModelIds {
+        // ComponentDetails::component, which names a row by its internalType
+        ComponentTypes::ComponentId componentOfType(std::string_view internalType);
+        std::string_view componentType(ComponentTypes::ComponentId id);
+
+        // ClothingItem::comp, which names a row by its displayName
+        ComponentTypes::ComponentId componentOfDisplayName(std::string_view displayName);
+        std::string_view componentDisplayName(ComponentTypes::ComponentId id);
+
+        // One past the highest component ID handed out so far, for arrays indexed by ID
+        size_t componentIdCount();
+
+        DlcInfo::DlcId dlcOfName(std::string_view name);
+        std::string_view dlcName(DlcInfo::DlcId id);
+
+        // "Name (dlcFileName)" for a DLC_LIST row; any other name as getDlcDisplayName shows it
+        std::string dlcDisplayName(DlcInfo::DlcId id);
+
+        // One past the highest DLC ID handed out so far, for arrays indexed by ID
+        size_t dlcIdCount();
+    }
+}
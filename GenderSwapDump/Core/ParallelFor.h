@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+    // Resolve a requested worker count: 0 means one per hardware thread,
+    // and there is never any point in more workers than tasks
+    inline unsigned resolveThreadCount(unsigned requested, size_t taskCount) {
+        unsigned threads = requested;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(taskCount, 1)));
+    }
+
+    // Run task(index) for every index in `order` on a pool of `threads` workers.
+    // Indices are handed out strictly in the given order, so callers control the
+    // schedule (e.g. largest file first). Results must be written to per-index
+    // slots; the first exception thrown by a task is rethrown on the caller.
+    template <typename Task>
+    void parallelFor(const std::vector<size_t>& order, unsigned threads, Task&& task) {
+        threads = resolveThreadCount(threads, order.size());
+
+        if (threads <= 1) {
+            for (size_t index : order) {
+                task(index);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next{0};
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+
+        auto worker = [&]() {
+            for (size_t slot = next++; slot < order.size(); slot = next++) {
+                try {
+                    task(order[slot]);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned i = 1; i < threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();  // The calling thread works too
+
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+
+namespace Core {
+    // Resident set size of this process in bytes, 0 where it cannot be read
+    size_t residentBytes();
+
+    // Ask the C heap to hand freed pages back to the OS, so a drop in use shows up in residentBytes()
+    void releaseFreeHeapMemory();
+}
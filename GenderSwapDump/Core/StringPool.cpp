@@ -0,0 +1,51 @@
+#include "StringPool.h"
+
+namespace Core {
+    StringPool& StringPool::global() {
+        static StringPool pool;
+        return pool;
+    }
+
+    StringPool::StringPool() {
+        strings.push_back(std::string_view(""));
+        index.emplace(strings.back(), EMPTY_ID);
+    }
+
+    StringPool::Id StringPool::internId(std::string_view text) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return insert(text);
+    }
+
+    std::string_view StringPool::intern(std::string_view text) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return strings[insert(text)];
+    }
+
+    StringPool::Id StringPool::insert(std::string_view text) {
+        auto it = index.find(text);
+        if (it != index.end()) {
+            return it->second;
+        }
+
+        std::string_view stored = arena.store(text);
+        Id id = static_cast<Id>(strings.size());
+        strings.push_back(stored);
+        index.emplace(stored, id);
+        return id;
+    }
+
+    std::string_view StringPool::view(Id id) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return id < strings.size() ? strings[id] : std::string_view();
+    }
+
+    size_t StringPool::count() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return strings.size();
+    }
+
+    size_t StringPool::bytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return arena.size();
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "StringStore.h"
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Core {
+    // Process-wide interning pool. Every distinct string is stored once in an arena
+    // and never moves, so views returned by intern() stay valid until exit and two
+    // interned views are equal exactly when their ids are. Safe to use from the
+    // parser worker threads.
+    class StringPool {
+    public:
+        using Id = uint32_t;
+        static constexpr Id EMPTY_ID = 0;  // The empty string always has id 0
+
+        static StringPool& global();
+
+        StringPool();
+        StringPool(const StringPool&) = delete;
+        StringPool& operator=(const StringPool&) = delete;
+
+        Id internId(std::string_view text);
+        std::string_view intern(std::string_view text);
+        std::string_view view(Id id) const;
+
+        size_t count() const;  // Distinct strings
+        size_t bytes() const;  // Arena bytes holding them
+
+    private:
+        Id insert(std::string_view text);  // Caller holds the mutex
+
+        mutable std::mutex mutex;
+        StringStore arena;
+        std::unordered_map<std::string_view, Id> index;
+        std::vector<std::string_view> strings;
+    };
+
+    // Shorthand for StringPool::global().intern()
+    inline std::string_view intern(std::string_view text) {
+        return StringPool::global().intern(text);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstring>
+
+namespace Core {
+    // Append-only arena for strings that must outlive the buffer they were read from.
+    // Text is packed into large chunks, so views handed out by store() stay valid for
+    // the lifetime of the store, including across moves of the store itself.
+    class StringStore {
+    public:
+        StringStore() = default;
+        StringStore(StringStore&&) noexcept = default;
+        StringStore& operator=(StringStore&&) noexcept = default;
+        StringStore(const StringStore&) = delete;
+        StringStore& operator=(const StringStore&) = delete;
+
+        std::string_view store(std::string_view text) {
+            if (text.empty()) {
+                return std::string_view();
+            }
+
+            // Oversized strings get a dedicated chunk so they don't waste the current one
+            if (text.size() > CHUNK_SIZE / 4) {
+                chunks.push_back(std::make_unique<char[]>(text.size()));
+                std::memcpy(chunks.back().get(), text.data(), text.size());
+                bytesStored += text.size();
+                return std::string_view(chunks.back().get(), text.size());
+            }
+
+            if (!current || CHUNK_SIZE - currentUsed < text.size()) {
+                chunks.push_back(std::make_unique<char[]>(CHUNK_SIZE));
+                current = chunks.back().get();
+                currentUsed = 0;
+            }
+
+            char* dst = current + currentUsed;
+            std::memcpy(dst, text.data(), text.size());
+            currentUsed += text.size();
+            bytesStored += text.size();
+            return std::string_view(dst, text.size());
+        }
+
+        size_t size() const { return bytesStored; }
+
+    private:
+        static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char* current{nullptr};
+        size_t currentUsed{0};
+        size_t bytesStored{0};
+    };
+}
@@ -0,0 +1,239 @@
+#include "TarBundle.h"
+#include "Compression.h"
+#include "Hash.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+    constexpr size_t BLOCK_SIZE = 512;
+
+    // Header field offsets and lengths (POSIX ustar)
+    constexpr size_t NAME_OFFSET = 0, NAME_LENGTH = 100;
+    constexpr size_t SIZE_OFFSET = 124, SIZE_LENGTH = 12;
+    constexpr size_t MTIME_OFFSET = 136, MTIME_LENGTH = 12;
+    constexpr size_t CHECKSUM_OFFSET = 148, CHECKSUM_LENGTH = 8;
+    constexpr size_t TYPE_OFFSET = 156;
+    constexpr size_t MAGIC_OFFSET = 257;
+    constexpr size_t PREFIX_OFFSET = 345, PREFIX_LENGTH = 155;
+
+    std::string_view field(const char* header, size_t offset, size_t length) {
+        std::string_view text(header + offset, length);
+        size_t nul = text.find('\0');
+        return nul == std::string_view::npos ? text : text.substr(0, nul);
+    }
+
+    // Octal, space/NUL padded; GNU base-256 when the top bit of the first byte is set
+    bool numericField(const char* header, size_t offset, size_t length, uint64_t& value) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(header + offset);
+        value = 0;
+        if (p[0] & 0x80) {
+            for (size_t i = 1; i < length; ++i) {
+                if (value >> 56) {
+                    return false;
+                }
+                value = (value << 8) | p[i];
+            }
+            return true;
+        }
+
+        size_t i = 0;
+        while (i < length && p[i] == ' ') {
+            ++i;
+        }
+        for (; i < length && p[i] >= '0' && p[i] <= '7'; ++i) {
+            value = value * 8 + (p[i] - '0');
+        }
+        return i == length || p[i] == ' ' || p[i] == '\0';
+    }
+
+    bool checksumMatches(const char* header) {
+        uint64_t stored;
+        if (!numericField(header, CHECKSUM_OFFSET, CHECKSUM_LENGTH, stored)) {
+            return false;
+        }
+        uint64_t sum = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            bool inChecksum = i >= CHECKSUM_OFFSET && i < CHECKSUM_OFFSET + CHECKSUM_LENGTH;
+            sum += inChecksum ? ' ' : static_cast<unsigned char>(header[i]);
+        }
+        return sum == stored;
+    }
+
+    bool isZeroBlock(const char* block) {
+        return std::all_of(block, block + BLOCK_SIZE, [](char c) { return c == '\0'; });
+    }
+
+    // Pax records are "<length> <key>=<value>\n"; only the path is of interest
+    std::string_view paxPath(std::string_view records) {
+        while (!records.empty()) {
+            size_t space = records.find(' ');
+            if (space == std::string_view::npos) {
+                break;
+            }
+            size_t length = 0;
+            for (char c : records.substr(0, space)) {
+                if (c < '0' || c > '9') {
+                    return std::string_view();
+                }
+                length = length * 10 + (c - '0');
+            }
+            if (length <= space || length > records.size()) {
+                break;
+            }
+
+            std::string_view record = records.substr(space + 1, length - space - 2);  // Drop the '\n'
+            if (record.substr(0, 5) == "path=") {
+                return record.substr(5);
+            }
+            records.remove_prefix(length);
+        }
+        return std::string_view();
+    }
+
+    std::string normalise(std::string_view path) {
+        while (path.substr(0, 2) == "./") {
+            path.remove_prefix(2);
+        }
+        return std::string(path);
+    }
+}
+
+namespace Core {
+    bool TarBundle::open(const std::string& path, std::string& error) {
+        members.clear();
+        index.clear();
+
+        if (!mapping.open(path, MappedFile::Access::CopyOnWrite)) {
+            error = "cannot map " + path;
+            return false;
+        }
+
+        char* base = mapping.data();
+        size_t size = mapping.size();
+        std::string longName;  // From a GNU 'L' or pax 'x' entry, applies to the next member
+
+        size_t offset = 0;
+        while (offset < size) {
+            if (size - offset < BLOCK_SIZE) {
+                error = "archive truncated at offset " + std::to_string(offset);
+                return false;
+            }
+            const char* header = base + offset;
+            if (isZeroBlock(header)) {
+                break;  // End-of-archive marker
+            }
+            if (!checksumMatches(header)) {
+                error = "bad header checksum at offset " + std::to_string(offset);
+                return false;
+            }
+
+            uint64_t memberSize;
+            uint64_t modified;
+            if (!numericField(header, SIZE_OFFSET, SIZE_LENGTH, memberSize) ||
+                !numericField(header, MTIME_OFFSET, MTIME_LENGTH, modified)) {
+                error = "malformed header at offset " + std::to_string(offset);
+                return false;
+            }
+
+            size_t dataOffset = offset + BLOCK_SIZE;
+            if (memberSize > size - dataOffset) {
+                error = "member at offset " + std::to_string(offset) + " runs past the end of the archive";
+                return false;
+            }
+            std::string_view data(base + dataOffset, static_cast<size_t>(memberSize));
+
+            char type = header[TYPE_OFFSET];
+            if (type == 'L') {
+                longName = std::string(field(data.data(), 0, data.size()));
+            }
+            else if (type == 'x') {
+                longName = std::string(paxPath(data));
+            }
+            else if (type == '0' || type == '\0' || type == '7') {
+                std::string name;
+                if (!longName.empty()) {
+                    name = std::move(longName);
+                }
+                else {
+                    std::string_view prefix;
+                    if (std::memcmp(header + MAGIC_OFFSET, "ustar", 5) == 0) {
+                        prefix = field(header, PREFIX_OFFSET, PREFIX_LENGTH);
+                    }
+                    std::string_view shortName = field(header, NAME_OFFSET, NAME_LENGTH);
+                    name = prefix.empty() ? std::string(shortName) : std::string(prefix) + "/" + std::string(shortName);
+                }
+
+                Member member;
+                member.path = normalise(name);
+                member.data = base + dataOffset;
+                member.size = static_cast<size_t>(memberSize);
+                member.modified = static_cast<int64_t>(modified);
+                members.push_back(std::move(member));
+                longName.clear();
+            }
+            else {
+                // Directories, links, devices, global pax headers: nothing to read
+                longName.clear();
+            }
+
+            offset = dataOffset + (static_cast<size_t>(memberSize) + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        }
+
+        // A later member with the same path replaces an earlier one, as tar extraction would
+        for (size_t i = 0; i < members.size(); ++i) {
+            index[members[i].path] = i;
+        }
+        return true;
+    }
+
+    const TarBundle::Member* TarBundle::find(std::string_view path) const {
+        while (path.substr(0, 2) == "./") {
+            path.remove_prefix(2);
+        }
+        auto it = index.find(path);
+        return it == index.end() ? nullptr : &members[it->second];
+    }
+
+    std::vector<std::string> TarBundle::list(std::string_view directory, std::string_view extension) const {
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < members.size(); ++i) {
+            const std::string& path = members[i].path;
+            if (index.at(path) != i) {
+                continue;  // Superseded by a later copy
+            }
+            bool inDirectory = path.size() > directory.size() && path.compare(0, directory.size(), directory) == 0;
+            if (inDirectory && Compression::matchesExtension(path, extension)) {
+                paths.push_back(path);
+            }
+        }
+        return paths;
+    }
+
+    bool TarBundle::stamp(std::string_view path, FileStamp& stamp, bool hashContents) const {
+        const Member* member = find(path);
+        if (!member) {
+            return false;
+        }
+        stamp.size = member->size;
+        stamp.modified = member->modified;
+        stamp.contentHash = hashContents ? Hash::contentHash(member->data, member->size) : 0;
+        return true;
+    }
+
+    bool readInputStamp(const TarBundle* bundle, const std::string& path, FileStamp& stamp, bool hashContents) {
+        if (bundle && bundle->find(path)) {
+            return bundle->stamp(path, stamp, hashContents);
+        }
+        return FileStamp::read(path, stamp, hashContents);
+    }
+
+    uint64_t inputSize(const TarBundle* bundle, const std::string& path) {
+        if (const TarBundle::Member* member = bundle ? bundle->find(path) : nullptr) {
+            return member->size;
+        }
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(path, ec);
+        return ec ? 0 : static_cast<uint64_t>(size);
+    }
+}
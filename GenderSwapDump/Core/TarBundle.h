@@ -0,0 +1,45 @@
+#pragma once
+#include "FileStamp.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Core {
+    // An uncompressed tar archive holding the whole corpus, mapped once so every member
+    // is parsed straight from its offset. Supports ustar/GNU/pax headers for regular files;
+    // directories, links and other entries are skipped. The mapping is copy-on-write, so
+    // in-place parsers may terminate strings inside a member without touching the archive.
+    class TarBundle {
+    public:
+        struct Member {
+            std::string path;     // As stored, minus any leading "./"
+            char* data{nullptr};
+            size_t size{0};
+            int64_t modified{0};  // Seconds since the epoch, from the header
+        };
+
+        bool open(const std::string& path, std::string& error);
+
+        const Member* find(std::string_view path) const;
+
+        // Members below `directory` with the given extension (compressed or not), in archive order
+        std::vector<std::string> list(std::string_view directory, std::string_view extension) const;
+
+        bool stamp(std::string_view path, FileStamp& stamp, bool hashContents = true) const;
+
+        size_t memberCount() const { return members.size(); }
+        size_t size() const { return mapping.size(); }
+
+    private:
+        MappedFile mapping;
+        std::vector<Member> members;
+        std::unordered_map<std::string_view, size_t> index;
+    };
+
+    // Input helpers that read the bundle member for `path` when there is one, otherwise the file on disk
+    bool readInputStamp(const TarBundle* bundle, const std::string& path, FileStamp& stamp, bool hashContents = true);
+    uint64_t inputSize(const TarBundle* bundle, const std::string& path);
+}
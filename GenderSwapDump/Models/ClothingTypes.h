@@ -3,6 +3,7 @@
 #include <string_view>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <memory>
 #include "../Core/Constants.h"
 
@@ -17,12 +18,14 @@ namespace Core {
         bool isDefault = false;
     };
 
+    // DLCs and component types are IDs (see Constants.h); ModelIds turns them into text
+    // when a report is written
     struct ComponentDetails {
-        std::string componentType;      // e.g. "HAT", "MASK", etc.
+        ComponentTypes::ComponentId component{ComponentTypes::NO_COMPONENT};  // internalType, e.g. "HAT", "MASK"
         int drawableId = -1;
         int textureId;
         std::vector<ComponentVariant> variants;
-        std::string dlcName;
+        DlcInfo::DlcId dlc{DlcInfo::NO_DLC};
     };
 
     struct OutfitComponent {
@@ -38,7 +41,7 @@ namespace Core {
         std::string outfitHash;
         std::string localizedName;
         std::string textLabel;      // GXT text label for localization
-        std::string dlcName;
+        DlcInfo::DlcId dlc{DlcInfo::NO_DLC};  // The shop meta file's <dlcName> as given
         std::vector<std::shared_ptr<OutfitComponent>> components;
         bool isComplete;  // Whether all components are available/unlocked
     };
@@ -55,8 +58,11 @@ namespace Core {
         std::shared_ptr<Outfit> parentOutfit;  // If this item is part of an outfit
         
         // Existing fields
-        std::string_view dlcName{Defaults::NA};
-        std::string_view comp{Defaults::UNKNOWN_COMPONENT};
+        DlcInfo::DlcId dlc{DlcInfo::UNSET_DLC};
+        // UNIFIED_COMPONENTS row, named by its displayName (e.g. "Torso 2"). Script metadata
+        // gives the displayName; a JSON-only item's shortType ("JBIB") is resolved to the same
+        // row, and only a shortType outside the table is kept as its own name.
+        ComponentTypes::ComponentId comp{ComponentTypes::UNSET_COMPONENT};
         std::string_view drawableId{Defaults::NA};
         std::string_view textureId{Defaults::NA};
         std::string_view itemName{Defaults::UNKNOWN_NAME};
@@ -71,7 +77,7 @@ namespace Core {
         }
 
         bool hasValidComponent() const {
-            return comp != Defaults::UNKNOWN_COMPONENT;
+            return comp != ComponentTypes::UNSET_COMPONENT;
         }
 
         bool isValid() const {
@@ -86,12 +92,37 @@ namespace Core {
     };
 
     struct ClothingCollection {
-        std::vector<ClothingItem> items;
+        std::vector<ClothingItem> items;  // Append through add() so the indexes below stay in step
         std::vector<std::shared_ptr<Outfit>> outfits;
 
+        // First item per key and per non-empty text label, as positions in items so they
+        // survive reallocation. Keys and labels are views that live as long as the items.
+        std::unordered_map<std::string_view, size_t> keyIndex;
+        std::unordered_map<std::string_view, size_t> textLabelIndex;
+
+        void add(const ClothingItem& item) {
+            keyIndex.try_emplace(item.m_key, items.size());
+            if (!item.m_textlabel.empty()) {
+                textLabelIndex.try_emplace(item.m_textlabel, items.size());
+            }
+            items.push_back(item);
+        }
+
+        ClothingItem* findByKey(std::string_view key) {
+            auto it = keyIndex.find(key);
+            return it != keyIndex.end() ? &items[it->second] : nullptr;
+        }
+
+        ClothingItem* findByTextLabel(std::string_view textLabel) {
+            auto it = textLabelIndex.find(textLabel);
+            return it != textLabelIndex.end() ? &items[it->second] : nullptr;
+        }
+
         void clear() {
             items.clear();
             outfits.clear();
+            keyIndex.clear();
+            textLabelIndex.clear();
         }
 
         size_t totalItems() const {
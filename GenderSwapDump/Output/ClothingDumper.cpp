@@ -1,7 +1,9 @@
 #include "ClothingDumper.h"
 #include "../Core/Constants.h"
+#include "../Core/ModelIds.h"
 #include <fstream>
 #include <map>
+#include <vector>
 #include <unordered_map>
 #include <iomanip>
 #include <sstream>
@@ -35,10 +37,10 @@ namespace Output {
             out << "+- Gender: " << std::string(item.m_gender) << "\n";
         
             writeIndent(out, indent + 4);
-            out << "+- Component Type: " << cleanComponentTypeName(item.componentDetails.componentType) << "\n";
+            out << "+- Component Type: " << cleanComponentTypeName(std::string(Core::ModelIds::componentType(item.componentDetails.component))) << "\n";
         
             writeIndent(out, indent + 4);
-            out << "+- DLC Pack: " << Core::ComponentUtils::getDlcDisplayName(item.componentDetails.dlcName) << "\n";
+            out << "+- DLC Pack: " << Core::ModelIds::dlcDisplayName(item.componentDetails.dlc) << "\n";
         
             writeIndent(out, indent + 4);
             out << "+- Technical Info:\n";
@@ -236,7 +238,7 @@ namespace Output {
         outFile << "Key: " << std::string(item->m_key) << "\n";
     
         writeIndent(outFile, indent);
-        outFile << "Component Type: " << item->componentDetails.componentType << "\n";
+        outFile << "Component Type: " << Core::ModelIds::componentType(item->componentDetails.component) << "\n";
     
         writeIndent(outFile, indent);
         outFile << "Drawable ID: " << item->componentDetails.drawableId << "\n";
@@ -245,7 +247,7 @@ namespace Output {
         outFile << "Texture ID: " << item->componentDetails.textureId << "\n";
     
         writeIndent(outFile, indent);
-                outFile << "DLC: " << Core::ComponentUtils::getDlcDisplayName(item->componentDetails.dlcName) << "\n";
+                outFile << "DLC: " << Core::ModelIds::dlcDisplayName(item->componentDetails.dlc) << "\n";
     
         // Pricing information removed as requested
     }
@@ -278,13 +280,13 @@ namespace Output {
 
     void ClothingDumper::dumpComponentDetails(std::ostream& out, const Core::ComponentDetails& component, int indent) {
         writeIndent(out, indent);
-        out << "Component Type: " << cleanComponentTypeName(component.componentType) << "\n";
+        out << "Component Type: " << cleanComponentTypeName(std::string(Core::ModelIds::componentType(component.component))) << "\n";
         writeIndent(out, indent);
         out << "Drawable ID: " << (component.drawableId != -1 ? std::to_string(component.drawableId) : "Not Available") << "\n";
         writeIndent(out, indent);
         out << "Texture ID: " << (component.textureId != -1 ? std::to_string(component.textureId) : "Not Available") << "\n";
         writeIndent(out, indent);
-        out << "DLC: " << Core::ComponentUtils::getDlcDisplayName(component.dlcName) << "\n";
+        out << "DLC: " << Core::ModelIds::dlcDisplayName(component.dlc) << "\n";
 
     
         // Unlock requirements removed - data is not useful (always empty or "None")
@@ -329,7 +331,7 @@ namespace Output {
         }
     
         writeIndent(out, indent);
-        out << "DLC: " << Core::ComponentUtils::getDlcDisplayName(outfit.dlcName) << "\n";
+        out << "DLC: " << Core::ModelIds::dlcDisplayName(outfit.dlc) << "\n";
         writeIndent(out, indent);
         out << "Status: " << (outfit.isComplete ? "Complete" : "Incomplete") << "\n";
 
@@ -448,9 +450,16 @@ namespace Output {
 
     void ClothingDumper::dumpComponentTypeStats(std::ostream& out,
                                              const Core::ClothingCollection& collection) {
-        std::map<std::string, int> componentCounts;
+        std::vector<int> countsById(Core::ModelIds::componentIdCount());
         for (const auto& item : collection.items) {
-            componentCounts[item.componentDetails.componentType]++;
+            countsById[item.componentDetails.component]++;
+        }
+
+        std::map<std::string_view, int> componentCounts;
+        for (size_t id = 0; id < countsById.size(); ++id) {
+            if (countsById[id] > 0) {
+                componentCounts[Core::ModelIds::componentType(static_cast<Core::ComponentTypes::ComponentId>(id))] += countsById[id];
+            }
         }
 
         out << "Items by Component Type:\n";
@@ -461,18 +470,27 @@ namespace Output {
 
     void ClothingDumper::dumpDLCStats(std::ostream& out,
                                     const Core::ClothingCollection& collection) {
-        std::map<std::string, std::pair<int, int>> dlcCounts; // items, outfits
+        std::vector<std::pair<int, int>> countsById(Core::ModelIds::dlcIdCount()); // items, outfits
     
         // Count items
         for (const auto& item : collection.items) {
-            std::string displayName = Core::ComponentUtils::getDlcDisplayName(item.componentDetails.dlcName);
-            dlcCounts[displayName].first++;
+            countsById[item.componentDetails.dlc].first++;
         }
     
         // Count outfits
         for (const auto& outfit : collection.outfits) {
-            std::string displayName = Core::ComponentUtils::getDlcDisplayName(outfit->dlcName);
-            dlcCounts[displayName].second++;
+            countsById[outfit->dlc].second++;
+        }
+
+        // Several IDs can share a display name, so merge by name for the report
+        std::map<std::string, std::pair<int, int>> dlcCounts;
+        for (size_t id = 0; id < countsById.size(); ++id) {
+            const auto& [items, outfits] = countsById[id];
+            if (items > 0 || outfits > 0) {
+                auto& counts = dlcCounts[Core::ModelIds::dlcDisplayName(static_cast<Core::DlcInfo::DlcId>(id))];
+                counts.first += items;
+                counts.second += outfits;
+            }
         }
 
         out << "Content by DLC:\n";
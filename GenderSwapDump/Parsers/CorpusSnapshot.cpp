@@ -0,0 +1,668 @@
+#include "CorpusSnapshot.h"
+#include "../Core/Constants.h"
+#include "../Core/Hash.h"
+#include "../Core/MappedFile.h"
+#include "../Core/ModelIds.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+    constexpr char MAGIC[8] = { 'G', 'S', 'D', 'S', 'N', 'A', 'P', '\0' };
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;  // Reads back differently on a foreign-endian host
+    constexpr size_t SECTION_ALIGNMENT = 8;
+
+    enum SectionId {
+        STRINGS,       // StringRef per string, index 0 is the empty string
+        STRING_BYTES,  // Concatenated string data
+        FILES,         // Manifest: one FileRecord per input file
+        JSON_ITEMS,
+        NODES,         // At most one per shop meta file
+        OUTFITS,
+        ITEMS,         // Node items, outfit components and outfit props
+        SCRIPT_ITEMS,  // Male items first, then female
+        SHOP_ITEMS,    // Side-table row per node item
+        LIST_VALUES,   // String index per side-table list entry
+        SECTION_COUNT
+    };
+
+    enum FileKind : uint32_t {
+        JSON_FILE,
+        XML_FILE,
+        SCRIPT_FILE
+    };
+
+    constexpr uint32_t NOT_VALIDATED = UINT32_MAX;
+
+    struct Section {
+        uint64_t offset;  // From the start of the file
+        uint64_t count;   // Records, or bytes for STRING_BYTES
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t byteOrder;
+        uint32_t version;
+        uint64_t headerSize;
+        uint64_t payloadSize;
+        uint64_t checksum;  // FNV-1a of this header (with checksum = 0) followed by the payload
+        uint64_t tables;    // Core::Tables fingerprint of the run that wrote it
+        Section sections[SECTION_COUNT];
+    };
+
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct FileRecord {
+        uint32_t path;
+        uint32_t kind;
+        uint64_t size;
+        int64_t modified;
+        uint64_t contentHash;
+        uint64_t numericErrors;
+        uint32_t first;      // Into JSON_ITEMS, NODES or SCRIPT_ITEMS depending on kind
+        uint32_t count;
+        uint32_t maleCount;  // SCRIPT_FILE: how many of its items are male
+        uint32_t schemaErrors;  // JSON_FILE: schema violations, NOT_VALIDATED if it was not checked
+    };
+
+    struct JsonRecord {
+        uint32_t filename;
+        uint32_t gxt;
+        uint32_t localized;
+        uint32_t component;
+        int32_t drawableId;
+        int32_t textureId;
+    };
+
+    struct ItemRecord {
+        uint32_t itemName;
+        uint32_t lockHash;
+        uint32_t textLabel;
+        uint32_t uniqueNameHash;
+        uint32_t eCompType;
+        uint32_t eAnchorPoint;
+        int32_t localDrawableIndex;
+        int32_t propIndex;
+        int32_t textureIndex;
+    };
+
+    struct ShopItemRecord {
+        int32_t cost;
+        int32_t drawableIndex;
+        uint32_t shopEnum;
+        uint32_t firstRestrictionTag;
+        uint32_t restrictionTagCount;
+        uint32_t firstForcedComponent;
+        uint32_t forcedComponentCount;
+        uint32_t firstVariantComponent;
+        uint32_t variantComponentCount;
+    };
+
+    struct OutfitRecord {
+        uint32_t outfitName;
+        uint32_t lockHash;
+        uint32_t textLabel;
+        uint32_t uniqueNameHash;
+        uint32_t firstComponent;
+        uint32_t componentCount;
+        uint32_t firstProp;
+        uint32_t propCount;
+    };
+
+    struct NodeRecord {
+        uint32_t pedName;
+        uint32_t dlcName;
+        uint32_t fullDlcName;
+        uint32_t firstOutfit;
+        uint32_t outfitCount;
+        uint32_t firstItem;
+        uint32_t itemCount;
+        uint32_t firstShopItem;
+        uint32_t shopItemCount;
+    };
+
+    struct ScriptRecord {
+        uint32_t key;
+        uint32_t value;
+        uint32_t comp;
+        uint32_t dlcName;
+    };
+
+    static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<FileRecord>,
+                  "Snapshot records are written and mapped as raw bytes");
+    static_assert(sizeof(Header) % SECTION_ALIGNMENT == 0, "Payload must start aligned");
+
+    // Builds the string table and record arrays in memory, then lays them out in one buffer
+    class SnapshotWriter {
+    public:
+        SnapshotWriter() {
+            str(std::string_view());
+        }
+
+        uint32_t str(std::string_view text) {
+            auto it = index.find(text);
+            if (it != index.end()) {
+                return it->second;
+            }
+            uint32_t id = static_cast<uint32_t>(refs.size());
+            refs.push_back({ static_cast<uint32_t>(bytes.size()), static_cast<uint32_t>(text.size()) });
+            bytes.append(text.data(), text.size());
+            index.emplace(text, id);  // Keyed by the caller's view, which outlives the writer
+            return id;
+        }
+
+        void addJsonFile(const JsonParser::FileResult& file, const std::vector<JsonItem>& source) {
+            FileRecord record = fileRecord(file.path, JSON_FILE, file.stamp, file.numericErrors);
+            record.schemaErrors = file.validated ? static_cast<uint32_t>(file.schemaErrors) : NOT_VALIDATED;
+            record.first = static_cast<uint32_t>(jsonItems.size());
+            record.count = static_cast<uint32_t>(file.itemCount);
+            for (size_t i = file.firstItem; i < file.firstItem + file.itemCount; ++i) {
+                const JsonItem& item = source[i];
+                jsonItems.push_back({ str(item.filename), str(item.GXT), str(item.localized), str(item.component),
+                                      item.drawableId, item.textureId });
+            }
+            files.push_back(record);
+        }
+
+        void addXmlFile(const XmlParser::FileResult& file) {
+            FileRecord record = fileRecord(file.path, XML_FILE, file.stamp, file.numericErrors);
+            record.first = static_cast<uint32_t>(nodes.size());
+            if (file.nodes) {
+                addNode((*file.nodes)[file.nodeIndex]);
+                record.count = 1;
+            }
+            files.push_back(record);
+        }
+
+        void addScriptFile(const std::string& path, const ScriptMetadataParser& parser) {
+            FileRecord record = fileRecord(path, SCRIPT_FILE, parser.getSourceStamp(), 0);
+            record.first = static_cast<uint32_t>(scriptItems.size());
+            record.maleCount = static_cast<uint32_t>(parser.getMaleItems().size());
+            for (const auto& item : parser.getMaleItems()) {
+                addScriptItem(item);
+            }
+            for (const auto& item : parser.getFemaleItems()) {
+                addScriptItem(item);
+            }
+            record.count = static_cast<uint32_t>(scriptItems.size()) - record.first;
+            files.push_back(record);
+        }
+
+        // Lay out header + sections; the caller fills the remaining header fields first
+        std::string finish(Header& header) {
+            std::string out(sizeof(Header), '\0');
+            appendSection(out, header.sections[STRINGS], refs);
+            appendSection(out, header.sections[STRING_BYTES], bytes);
+            appendSection(out, header.sections[FILES], files);
+            appendSection(out, header.sections[JSON_ITEMS], jsonItems);
+            appendSection(out, header.sections[NODES], nodes);
+            appendSection(out, header.sections[OUTFITS], outfits);
+            appendSection(out, header.sections[ITEMS], items);
+            appendSection(out, header.sections[SCRIPT_ITEMS], scriptItems);
+            appendSection(out, header.sections[SHOP_ITEMS], shopItems);
+            appendSection(out, header.sections[LIST_VALUES], listValues);
+
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.byteOrder = BYTE_ORDER_MARK;
+            header.version = CorpusSnapshot::FORMAT_VERSION;
+            header.headerSize = sizeof(Header);
+            header.payloadSize = out.size() - sizeof(Header);
+            header.checksum = 0;
+            std::memcpy(&out[0], &header, sizeof(Header));
+            header.checksum = Core::Hash::fnv1a64(out.data(), out.size());
+            std::memcpy(&out[0], &header, sizeof(Header));
+            return out;
+        }
+
+    private:
+        std::unordered_map<std::string_view, uint32_t> index;
+        std::vector<StringRef> refs;
+        std::string bytes;
+        std::vector<FileRecord> files;
+        std::vector<JsonRecord> jsonItems;
+        std::vector<NodeRecord> nodes;
+        std::vector<OutfitRecord> outfits;
+        std::vector<ItemRecord> items;
+        std::vector<ScriptRecord> scriptItems;
+        std::vector<ShopItemRecord> shopItems;
+        std::vector<uint32_t> listValues;
+
+        FileRecord fileRecord(std::string_view path, FileKind kind, const Core::FileStamp& stamp,
+                              size_t numericErrors) {
+            FileRecord record{};
+            record.path = str(path);
+            record.kind = kind;
+            record.size = stamp.size;
+            record.modified = stamp.modified;
+            record.contentHash = stamp.contentHash;
+            record.numericErrors = numericErrors;
+            return record;
+        }
+
+        void addNode(const XmlNode& node) {
+            NodeRecord record{};
+            record.pedName = str(node.pedName);
+            record.dlcName = str(node.dlcName);
+            record.fullDlcName = str(node.fullDlcName);
+            record.firstOutfit = static_cast<uint32_t>(outfits.size());
+            record.outfitCount = static_cast<uint32_t>(node.outfits.size());
+            for (const auto& outfit : node.outfits) {
+                OutfitRecord outfitRecord{};
+                outfitRecord.outfitName = str(outfit.outfitName);
+                outfitRecord.lockHash = str(outfit.lockHash);
+                outfitRecord.textLabel = str(outfit.textLabel);
+                outfitRecord.uniqueNameHash = str(outfit.uniqueNameHash);
+                outfitRecord.firstComponent = addItems(outfit.components);
+                outfitRecord.componentCount = static_cast<uint32_t>(outfit.components.size());
+                outfitRecord.firstProp = addItems(outfit.props);
+                outfitRecord.propCount = static_cast<uint32_t>(outfit.props.size());
+                outfits.push_back(outfitRecord);
+            }
+            record.firstItem = addItems(node.items);
+            record.itemCount = static_cast<uint32_t>(node.items.size());
+            record.firstShopItem = static_cast<uint32_t>(shopItems.size());
+            record.shopItemCount = static_cast<uint32_t>(node.columns.rows());
+            const ShopItemColumns& columns = node.columns;
+            for (size_t row = 0; row < columns.rows(); ++row) {
+                ShopItemRecord shopItem{};
+                shopItem.cost = columns.cost[row];
+                shopItem.drawableIndex = columns.drawableIndex[row];
+                shopItem.shopEnum = str(columns.shopEnum[row]);
+                shopItem.firstRestrictionTag = addListRow(columns.restrictionTags, row, shopItem.restrictionTagCount);
+                shopItem.firstForcedComponent = addListRow(columns.forcedComponents, row, shopItem.forcedComponentCount);
+                shopItem.firstVariantComponent = addListRow(columns.variantComponents, row, shopItem.variantComponentCount);
+                shopItems.push_back(shopItem);
+            }
+            nodes.push_back(record);
+        }
+
+        uint32_t addListRow(const ShopItemListColumn& column, size_t row, uint32_t& count) {
+            uint32_t first = static_cast<uint32_t>(listValues.size());
+            count = column.count(row);
+            for (uint32_t i = column.first(row); i < column.first(row) + count; ++i) {
+                listValues.push_back(str(column.values[i]));
+            }
+            return first;
+        }
+
+        void addScriptItem(const Core::ClothingItem& item) {
+            // By name: IDs past the table rows are handed out per run. Table edits are caught
+            // by the header's fingerprint instead
+            scriptItems.push_back({ str(item.m_key), str(item.value), str(Core::ModelIds::componentDisplayName(item.comp)),
+                                    str(Core::ModelIds::dlcName(item.dlc)) });
+        }
+
+        uint32_t addItems(const std::vector<XmlItem>& source) {
+            uint32_t first = static_cast<uint32_t>(items.size());
+            for (const auto& item : source) {
+                items.push_back({ str(item.itemName), str(item.lockHash), str(item.textLabel),
+                                  str(item.uniqueNameHash), str(item.eCompType), str(item.eAnchorPoint),
+                                  item.localDrawableIndex, item.propIndex, item.textureIndex });
+            }
+            return first;
+        }
+
+        template <typename Container>
+        static void appendSection(std::string& out, Section& section, const Container& records) {
+            out.resize((out.size() + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT, '\0');
+            section.offset = out.size();
+            section.count = records.size();
+            out.append(reinterpret_cast<const char*>(records.data()),
+                       records.size() * sizeof(typename Container::value_type));
+        }
+    };
+
+    // Bounds-checked typed view of one section of a mapped snapshot
+    template <typename T>
+    bool sectionView(const Core::MappedFile& file, const Section& section, const T*& records) {
+        if (section.offset % alignof(T) != 0 || section.offset > file.size() ||
+            section.count > (file.size() - section.offset) / sizeof(T)) {
+            return false;
+        }
+        records = reinterpret_cast<const T*>(file.data() + section.offset);
+        return true;
+    }
+}
+
+CorpusSnapshot::CorpusSnapshot(std::shared_ptr<Core::ILogger> logger, std::shared_ptr<const Core::TarBundle> bundle,
+                               uint64_t tables)
+    : logger(std::move(logger))
+    , bundle(std::move(bundle))
+    , tables(tables)
+{
+}
+
+
+void CorpusSnapshot::clear() {
+    stringBytes.clear();
+    jsonFiles.clear();
+    xmlFiles.clear();
+    scriptFile = ScriptFile();
+    hasScriptFile = false;
+    jsonIndex.clear();
+    xmlIndex.clear();
+    touchedFiles = 0;
+}
+
+bool CorpusSnapshot::load(const std::string& path) {
+    try {
+        clear();
+
+        Core::MappedFile mapping;
+        if (!mapping.open(path)) {
+            logger->log("No corpus snapshot at " + path);
+            return false;
+        }
+
+        auto reject = [&](const std::string& reason) {
+            logger->log("Ignoring corpus snapshot " + path + ": " + reason);
+            clear();
+            return false;
+        };
+
+        Header header;
+        if (mapping.size() < sizeof(Header)) {
+            return reject("truncated header");
+        }
+        std::memcpy(&header, mapping.data(), sizeof(Header));
+
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK) {
+            return reject("not a snapshot for this platform");
+        }
+        if (header.version != FORMAT_VERSION || header.headerSize != sizeof(Header)) {
+            return reject("format version " + std::to_string(header.version) + ", expected " +
+                          std::to_string(FORMAT_VERSION));
+        }
+        if (header.payloadSize != mapping.size() - sizeof(Header)) {
+            return reject("size mismatch");
+        }
+        if (header.tables != tables) {
+            return reject("written with different DLC or component tables");
+        }
+        Header unsignedHeader = header;
+        unsignedHeader.checksum = 0;
+        uint64_t checksum = Core::Hash::fnv1a64(&unsignedHeader, sizeof(Header));
+        if (Core::Hash::fnv1a64(mapping.data() + sizeof(Header), header.payloadSize, checksum) != header.checksum) {
+            return reject("checksum mismatch");
+        }
+
+        const StringRef* refs;
+        const char* bytes;
+        const FileRecord* fileRecords;
+        const JsonRecord* jsonRecords;
+        const NodeRecord* nodeRecords;
+        const OutfitRecord* outfitRecords;
+        const ItemRecord* itemRecords;
+        const ScriptRecord* scriptRecords;
+        const ShopItemRecord* shopItemRecords;
+        const uint32_t* listRecords;
+        const Section* sections = header.sections;
+        if (!sectionView(mapping, sections[STRINGS], refs) ||
+            !sectionView(mapping, sections[STRING_BYTES], bytes) ||
+            !sectionView(mapping, sections[FILES], fileRecords) ||
+            !sectionView(mapping, sections[JSON_ITEMS], jsonRecords) ||
+            !sectionView(mapping, sections[NODES], nodeRecords) ||
+            !sectionView(mapping, sections[OUTFITS], outfitRecords) ||
+            !sectionView(mapping, sections[ITEMS], itemRecords) ||
+            !sectionView(mapping, sections[SCRIPT_ITEMS], scriptRecords) ||
+            !sectionView(mapping, sections[SHOP_ITEMS], shopItemRecords) ||
+            !sectionView(mapping, sections[LIST_VALUES], listRecords)) {
+            return reject("section out of bounds");
+        }
+
+        stringBytes.assign(bytes, sections[STRING_BYTES].count);
+        std::vector<std::string_view> strings(sections[STRINGS].count);
+        for (size_t i = 0; i < strings.size(); ++i) {
+            if (refs[i].offset > stringBytes.size() || refs[i].length > stringBytes.size() - refs[i].offset) {
+                return reject("string table out of bounds");
+            }
+            strings[i] = std::string_view(stringBytes.data() + refs[i].offset, refs[i].length);
+        }
+
+        // Every index is checked; a bad one poisons the load instead of reading out of bounds
+        bool corrupt = false;
+        auto str = [&](uint32_t id) {
+            if (id >= strings.size()) {
+                corrupt = true;
+                return std::string_view();
+            }
+            return strings[id];
+        };
+        auto inRange = [&](uint64_t first, uint64_t count, uint64_t total) {
+            corrupt = corrupt || first > total || count > total - first;
+            return !corrupt;
+        };
+        auto readItems = [&](uint32_t first, uint32_t count, std::vector<XmlItem>& out) {
+            if (!inRange(first, count, sections[ITEMS].count)) {
+                return;
+            }
+            out.reserve(count);
+            for (const ItemRecord* record = itemRecords + first; record != itemRecords + first + count; ++record) {
+                XmlItem item;
+                item.itemName = str(record->itemName);
+                item.lockHash = str(record->lockHash);
+                item.textLabel = str(record->textLabel);
+                item.uniqueNameHash = str(record->uniqueNameHash);
+                item.eCompType = str(record->eCompType);
+                item.eAnchorPoint = str(record->eAnchorPoint);
+                item.localDrawableIndex = record->localDrawableIndex;
+                item.propIndex = record->propIndex;
+                item.textureIndex = record->textureIndex;
+                out.push_back(item);
+            }
+        };
+        auto readListRow = [&](uint32_t first, uint32_t count, ShopItemListColumn& column) {
+            if (inRange(first, count, sections[LIST_VALUES].count)) {
+                for (uint32_t i = first; i < first + count; ++i) {
+                    column.values.push_back(str(listRecords[i]));
+                }
+            }
+            column.endRow();
+        };
+        auto readColumns = [&](uint32_t first, uint32_t count, ShopItemColumns& columns) {
+            if (!inRange(first, count, sections[SHOP_ITEMS].count)) {
+                return;
+            }
+            columns.cost.reserve(count);
+            columns.drawableIndex.reserve(count);
+            columns.shopEnum.reserve(count);
+            for (const ShopItemRecord* record = shopItemRecords + first; record != shopItemRecords + first + count; ++record) {
+                columns.cost.push_back(record->cost);
+                columns.drawableIndex.push_back(record->drawableIndex);
+                columns.shopEnum.push_back(str(record->shopEnum));
+                readListRow(record->firstRestrictionTag, record->restrictionTagCount, columns.restrictionTags);
+                readListRow(record->firstForcedComponent, record->forcedComponentCount, columns.forcedComponents);
+                readListRow(record->firstVariantComponent, record->variantComponentCount, columns.variantComponents);
+            }
+        };
+        auto readNode = [&](const NodeRecord& record, XmlNode& node) {
+            node.pedName = str(record.pedName);
+            node.dlcName = str(record.dlcName);
+            node.fullDlcName = str(record.fullDlcName);
+            if (inRange(record.firstOutfit, record.outfitCount, sections[OUTFITS].count)) {
+                node.outfits.resize(record.outfitCount);
+                for (uint32_t o = 0; o < record.outfitCount; ++o) {
+                    const OutfitRecord& outfitRecord = outfitRecords[record.firstOutfit + o];
+                    XmlOutfit& outfit = node.outfits[o];
+                    outfit.outfitName = str(outfitRecord.outfitName);
+                    outfit.lockHash = str(outfitRecord.lockHash);
+                    outfit.textLabel = str(outfitRecord.textLabel);
+                    outfit.uniqueNameHash = str(outfitRecord.uniqueNameHash);
+                    readItems(outfitRecord.firstComponent, outfitRecord.componentCount, outfit.components);
+                    readItems(outfitRecord.firstProp, outfitRecord.propCount, outfit.props);
+                }
+            }
+            readItems(record.firstItem, record.itemCount, node.items);
+            corrupt = corrupt || record.shopItemCount != record.itemCount;
+            readColumns(record.firstShopItem, record.shopItemCount, node.columns);
+        };
+
+        for (size_t f = 0; f < sections[FILES].count && !corrupt; ++f) {
+            const FileRecord& record = fileRecords[f];
+            Core::FileStamp stamp;
+            stamp.size = record.size;
+            stamp.modified = record.modified;
+            stamp.contentHash = record.contentHash;
+
+            if (record.kind == JSON_FILE && inRange(record.first, record.count, sections[JSON_ITEMS].count)) {
+                JsonFile file;
+                file.path = str(record.path);
+                file.stamp = stamp;
+                file.numericErrors = static_cast<size_t>(record.numericErrors);
+                file.validated = record.schemaErrors != NOT_VALIDATED;
+                file.schemaErrors = file.validated ? record.schemaErrors : 0;
+                file.items.reserve(record.count);
+                for (const JsonRecord* item = jsonRecords + record.first; item != jsonRecords + record.first + record.count; ++item) {
+                    JsonItem jsonItem;
+                    jsonItem.filename = str(item->filename);
+                    jsonItem.GXT = str(item->gxt);
+                    jsonItem.localized = str(item->localized);
+                    jsonItem.component = str(item->component);
+                    jsonItem.drawableId = item->drawableId;
+                    jsonItem.textureId = item->textureId;
+                    file.items.push_back(jsonItem);
+                }
+                jsonFiles.push_back(std::move(file));
+            }
+            else if (record.kind == XML_FILE && record.count <= 1 &&
+                     inRange(record.first, record.count, sections[NODES].count)) {
+                XmlFile file;
+                file.path = str(record.path);
+                file.stamp = stamp;
+                file.numericErrors = static_cast<size_t>(record.numericErrors);
+                if (record.count == 1) {
+                    readNode(nodeRecords[record.first], file.node);
+                }
+                xmlFiles.push_back(std::move(file));
+            }
+            else if (record.kind == SCRIPT_FILE && !hasScriptFile && record.maleCount <= record.count &&
+                     inRange(record.first, record.count, sections[SCRIPT_ITEMS].count)) {
+                scriptFile.path = str(record.path);
+                scriptFile.stamp = stamp;
+                for (uint32_t i = 0; i < record.count; ++i) {
+                    const ScriptRecord& item = scriptRecords[record.first + i];
+                    Core::ClothingItem clothingItem;
+                    clothingItem.m_key = str(item.key);
+                    clothingItem.value = str(item.value);
+                    clothingItem.comp = Core::ModelIds::componentOfDisplayName(str(item.comp));
+                    clothingItem.dlc = Core::ModelIds::dlcOfName(str(item.dlcName));
+                    if (i < record.maleCount) {
+                        clothingItem.m_gender = Core::GenderIdentifiers::MALE_STR;
+                        scriptFile.maleItems.push_back(clothingItem);
+                    }
+                    else {
+                        clothingItem.m_gender = Core::GenderIdentifiers::FEMALE_STR;
+                        scriptFile.femaleItems.push_back(clothingItem);
+                    }
+                }
+                hasScriptFile = true;
+            }
+            else {
+                corrupt = true;
+            }
+        }
+
+        if (corrupt) {
+            return reject("record index out of bounds");
+        }
+
+        for (size_t i = 0; i < jsonFiles.size(); ++i) {
+            jsonIndex.emplace(jsonFiles[i].path, i);
+        }
+        for (size_t i = 0; i < xmlFiles.size(); ++i) {
+            xmlIndex.emplace(xmlFiles[i].path, i);
+        }
+
+        logger->log("Corpus snapshot loaded: " + std::to_string(fileCount()) + " files, " +
+                    std::to_string(strings.size()) + " strings, " + std::to_string(mapping.size()) + " bytes");
+        return true;
+    }
+    catch (const std::exception& e) {
+        logger->error(std::string("Exception in CorpusSnapshot::load: ") + e.what());
+        clear();
+        return false;
+    }
+}
+
+// Size and mtime equal: trust it. Same size but touched: compare contents, so a file that
+// was copied or re-saved without edits is still reused.
+bool CorpusSnapshot::unchanged(const std::string& path, const Core::FileStamp& cached, Core::FileStamp& stamp) {
+    if (!Core::readInputStamp(bundle.get(), path, stamp, false) || stamp.size != cached.size) {
+        return false;
+    }
+    if (stamp.modified == cached.modified) {
+        stamp.contentHash = cached.contentHash;
+        return true;
+    }
+    if (!Core::readInputStamp(bundle.get(), path, stamp) || stamp.contentHash != cached.contentHash) {
+        return false;
+    }
+    ++touchedFiles;
+    return true;
+}
+
+CorpusSnapshot::JsonFile* CorpusSnapshot::findJsonFile(const std::string& path, Core::FileStamp& stamp) {
+    auto it = jsonIndex.find(path);
+    if (it == jsonIndex.end()) {
+        return nullptr;
+    }
+    JsonFile& file = jsonFiles[it->second];
+    return unchanged(path, file.stamp, stamp) ? &file : nullptr;
+}
+
+CorpusSnapshot::XmlFile* CorpusSnapshot::findXmlFile(const std::string& path, Core::FileStamp& stamp) {
+    auto it = xmlIndex.find(path);
+    if (it == xmlIndex.end()) {
+        return nullptr;
+    }
+    XmlFile& file = xmlFiles[it->second];
+    return unchanged(path, file.stamp, stamp) ? &file : nullptr;
+}
+
+CorpusSnapshot::ScriptFile* CorpusSnapshot::findScriptFile(const std::string& path, Core::FileStamp& stamp) {
+    if (!hasScriptFile || scriptFile.path != path) {
+        return nullptr;
+    }
+    return unchanged(path, scriptFile.stamp, stamp) ? &scriptFile : nullptr;
+}
+
+bool CorpusSnapshot::write(const std::string& path, const JsonParser& jsonParser, const XmlParser& xmlParser,
+                           const ScriptMetadataParser& scriptParser, Core::ILogger& logger, uint64_t tables) {
+    try {
+        SnapshotWriter writer;
+        for (const auto& file : jsonParser.getFileResults()) {
+            writer.addJsonFile(file, jsonParser.getItems());
+        }
+        for (const auto& file : xmlParser.getFileResults()) {
+            writer.addXmlFile(file);
+        }
+        writer.addScriptFile(scriptParser.getSourcePath(), scriptParser);
+
+        Header header{};
+        header.tables = tables;
+        std::string buffer = writer.finish(header);
+
+        // Write beside the target and rename, so a crash never leaves a half-written snapshot
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+                logger.error("Failed to write corpus snapshot: " + tempPath);
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path);
+
+        logger.log("Corpus snapshot written: " + path + " (" + std::to_string(buffer.size()) + " bytes)");
+        return true;
+    }
+    catch (const std::exception& e) {
+        logger.error(std::string("Exception in CorpusSnapshot::write: ") + e.what());
+        return false;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "../Core/Constants.h"
+#include "../Core/Interfaces.h"
+#include "../Core/FileStamp.h"
+#include "../Core/TarBundle.h"
+#include "../Models/ClothingTypes.h"
+#include "JsonParser.h"
+#include "XmlParser.h"
+#include "ScriptMetadataParser.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Binary cache of what the three parsers produced, kept per input file, so a run only
+// re-parses files that were added or changed since the snapshot was written.
+//
+// Layout: a fixed Header, then a payload of 8-byte aligned sections. Strings live once
+// in a string table (StringRef array + byte blob) and records refer to them by index;
+// the manifest has one record per input file (path, size, mtime, content hash) pointing
+// at that file's range of JSON items, its shop meta node or the script metadata items.
+// Nodes, outfits and items are flat arrays linked by first/count ranges; a node's
+// side-table rows are one record per item, their list entries a shared array of string
+// indices. The header carries a format version, an FNV-1a checksum and the fingerprint of
+// the DLC and component tables (script items and JSON items hold names resolved through
+// them), and any mismatch makes load() fail so the caller parses everything.
+//
+// Cached string_views point into this object, so it must outlive the results handed to
+// the parsers; each parser keeps a reference for that reason.
+class CorpusSnapshot {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 6;
+
+    struct JsonFile {
+        std::string_view path;
+        Core::FileStamp stamp;
+        size_t numericErrors{0};
+        bool validated{false};  // Checked against the item schema when it was parsed
+        size_t schemaErrors{0};
+        std::vector<JsonItem> items;
+    };
+
+    struct XmlFile {
+        std::string_view path;
+        Core::FileStamp stamp;
+        size_t numericErrors{0};
+        XmlNode node;  // Empty for a file whose node the parser did not keep
+    };
+
+    struct ScriptFile {
+        std::string_view path;
+        Core::FileStamp stamp;
+        std::vector<Core::ClothingItem> maleItems;
+        std::vector<Core::ClothingItem> femaleItems;
+    };
+
+    // With a bundle, files are compared against its members instead of the disk. A snapshot
+    // written with another `tables` fingerprint is rejected.
+    explicit CorpusSnapshot(std::shared_ptr<Core::ILogger> logger, std::shared_ptr<const Core::TarBundle> bundle = nullptr,
+                            uint64_t tables = Core::Tables::FINGERPRINT);
+
+    // Map and validate a snapshot; false if missing or corrupt
+    bool load(const std::string& path);
+
+    static bool write(const std::string& path, const JsonParser& jsonParser, const XmlParser& xmlParser,
+                      const ScriptMetadataParser& scriptParser, Core::ILogger& logger,
+                      uint64_t tables = Core::Tables::FINGERPRINT);
+
+    // Cached results for `path` if the file is unchanged, otherwise nullptr. `stamp` receives
+    // the file's current stamp either way (without a content hash when it was not needed).
+    // Each entry is meant to be taken once: callers may move the results out.
+    JsonFile* findJsonFile(const std::string& path, Core::FileStamp& stamp);
+    XmlFile* findXmlFile(const std::string& path, Core::FileStamp& stamp);
+    ScriptFile* findScriptFile(const std::string& path, Core::FileStamp& stamp);
+
+    size_t fileCount() const { return jsonFiles.size() + xmlFiles.size() + (hasScriptFile ? 1 : 0); }
+
+    // Files that matched by content hash after their modification time changed; rewriting the
+    // snapshot records the new times so the next run can skip hashing them
+    size_t touchedFileCount() const { return touchedFiles; }
+
+private:
+    std::shared_ptr<Core::ILogger> logger;
+    std::shared_ptr<const Core::TarBundle> bundle;
+    uint64_t tables;
+    std::string stringBytes;  // Copied out of the mapping so the file can be replaced while in use
+    std::vector<JsonFile> jsonFiles;
+    std::vector<XmlFile> xmlFiles;
+    ScriptFile scriptFile;
+    bool hasScriptFile{false};
+    std::unordered_map<std::string_view, size_t> jsonIndex;
+    std::unordered_map<std::string_view, size_t> xmlIndex;
+    std::atomic<size_t> touchedFiles{0};  // Parsers look files up from worker threads
+
+    void clear();
+    bool unchanged(const std::string& path, const Core::FileStamp& cached, Core::FileStamp& stamp);
+};
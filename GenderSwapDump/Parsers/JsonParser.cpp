@@ -1,31 +1,385 @@
 #include "JsonParser.h"
+#include "rapidjson/encodedstream.h"
 #include "rapidjson/istreamwrapper.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/schema.h"
+#include "rapidjson/error/en.h"
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include "../Core/Compression.h"
 #include "../Core/Constants.h"
+#include "../Core/ParallelFor.h"
+#include "../Core/StringPool.h"
+#include "CorpusSnapshot.h"
 
-JsonParser::JsonParser(std::shared_ptr<Core::ILogger> logger)
+namespace {
+    // Writable, length-bounded stream for in-situ parsing of a mapped file.
+    // rapidjson's InsituStringStream relies on a trailing '\0', which a mapping
+    // does not have, so the end of the buffer is reported as '\0' instead.
+    class MappedInsituStream {
+    public:
+        typedef char Ch;
+
+        MappedInsituStream(char* begin, size_t size)
+            : src(begin), dst(nullptr), head(begin), end(begin + size) {}
+
+        Ch Peek() const { return src < end ? *src : '\0'; }
+        Ch Take() { return src < end ? *src++ : '\0'; }
+        size_t Tell() const { return static_cast<size_t>(src - head); }
+
+        Ch* PutBegin() { return dst = src; }
+        void Put(Ch c) { *dst++ = c; }
+        size_t PutEnd(Ch* begin) { return static_cast<size_t>(dst - begin); }
+
+        Ch* Push(size_t count) { Ch* begin = dst; dst += count; return begin; }
+        void Pop(size_t count) { dst -= count; }
+        void Flush() {}
+
+    private:
+        Ch* src;
+        Ch* dst;
+        Ch* head;
+        Ch* end;
+    };
+
+    template <typename Value>
+    std::string_view toView(const Value& value) {
+        return std::string_view(value.GetString(), value.GetStringLength());
+    }
+
+    // Every file is drawable -> texture -> item; an item needs a string GXT and Localized.
+    // Other item members (hair tattoo overlays and the like) are left alone.
+    constexpr std::string_view ITEM_SCHEMA = R"({
+        "type": "object",
+        "additionalProperties": {
+            "type": "object",
+            "additionalProperties": {
+                "type": "object",
+                "required": ["GXT", "Localized"],
+                "properties": {
+                    "GXT": { "type": "string" },
+                    "Localized": { "type": "string" }
+                }
+            }
+        }
+    })";
+
+    // Compiled once and shared: a SchemaDocument is read-only once built
+    const rapidjson::SchemaDocument& itemSchema() {
+        static const rapidjson::SchemaDocument schema = [] {
+            rapidjson::Document document;
+            document.Parse(ITEM_SCHEMA.data(), ITEM_SCHEMA.size());
+            return rapidjson::SchemaDocument(document);
+        }();
+        return schema;
+    }
+
+    // Counts a validator's errors (one entry per keyword, an array once it repeats) and
+    // describes the first as "<keyword> at <document pointer>"
+    template <typename Value>
+    void collectSchemaErrors(const Value& errors, size_t& count, std::string& first) {
+        for (auto it = errors.MemberBegin(); it != errors.MemberEnd(); ++it) {
+            const Value& entries = it->value;
+            count += entries.IsArray() ? entries.Size() : 1;
+            if (!first.empty() || (entries.IsArray() && entries.Empty())) {
+                continue;
+            }
+            const Value& entry = entries.IsArray() ? entries[0] : entries;
+            first = std::string(toView(it->name));
+            auto missing = entry.FindMember("missing");
+            if (missing != entry.MemberEnd() && missing->value.IsArray()) {
+                for (const auto& name : missing->value.GetArray()) {
+                    first += " " + std::string(toView(name));
+                }
+            }
+            auto location = entry.FindMember("instanceRef");
+            first += " at " + (location != entry.MemberEnd() ? std::string(toView(location->value)) : "#");
+        }
+    }
+
+    // Parses `stream` into `handler` with the schema validator between the two, so a
+    // DOM or SAX consumer gets validation in the same pass. In Report mode the validator
+    // keeps going after a violation and still forwards every event.
+    template <unsigned parseFlags, typename Stream, typename Handler>
+    rapidjson::ParseResult parseValidated(Stream& stream, Handler& handler, JsonValidation validation,
+                                          size_t& schemaErrors, std::string& schemaError) {
+        rapidjson::Reader reader;
+        if (validation == JsonValidation::Off) {
+            return reader.Parse<parseFlags>(stream, handler);
+        }
+
+        rapidjson::GenericSchemaValidator<rapidjson::SchemaDocument, Handler> validator(itemSchema(), handler);
+        if (validation == JsonValidation::Report) {
+            validator.SetValidateFlags(rapidjson::kValidateContinueOnErrorFlag);
+        }
+        rapidjson::ParseResult result = reader.Parse<parseFlags>(stream, validator);
+        if (!validator.IsValid()) {
+            collectSchemaErrors(validator.GetError(), schemaErrors, schemaError);
+        }
+        return result;
+    }
+
+    // The same for a DOM: the document is built from the validated events
+    template <unsigned parseFlags, typename Stream>
+    rapidjson::ParseResult populateValidated(rapidjson::Document& document, Stream& stream, JsonValidation validation,
+                                             size_t& schemaErrors, std::string& schemaError) {
+        rapidjson::ParseResult result;
+        auto generator = [&](rapidjson::Document& handler) {
+            result = parseValidated<parseFlags>(stream, handler, validation, schemaErrors, schemaError);
+            return !result.IsError();
+        };
+        document.Populate(generator);
+        return result;
+    }
+
+    // Drawable/texture keys are converted once here; failures are logged and counted
+    int32_t parseIdKey(std::string_view text, std::string_view what, std::string_view filename,
+                       size_t& numericErrors, Core::ILogger& logger) {
+        int32_t id;
+        if (!Core::ComponentUtils::parseId(text, id)) {
+            ++numericErrors;
+            logger.error("Invalid " + std::string(what) + " '" + std::string(text) + "' in " + std::string(filename));
+        }
+        return id;
+    }
+
+    // SAX handler for the drawable -> texture -> {GXT, Localized} layout.
+    // Emits one JsonItem per texture object as soon as it closes and copies only
+    // the strings an item keeps into the parser's string store.
+    class JsonItemHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JsonItemHandler> {
+    public:
+        enum class Field { None, Gxt, Localized };
+
+        JsonItemHandler(std::string_view filename, std::string_view component,
+                        Core::StringStore& strings, std::vector<JsonItem>& items,
+                        size_t& numericErrors, Core::ILogger& logger)
+            : filename(filename), component(component), strings(strings), items(items)
+            , numericErrors(numericErrors), logger(logger) {}
+
+        bool StartObject() {
+            if (arrayDepth == 0) {
+                ++depth;
+                if (depth == 3) {
+                    current = JsonItem();
+                    current.filename = filename;
+                    current.component = component;
+                    current.drawableId = drawableId;
+                    current.textureId = textureId;
+                }
+            }
+            return true;
+        }
+
+        bool Key(const char* str, rapidjson::SizeType length, bool) {
+            if (arrayDepth != 0) {
+                return true;
+            }
+
+            std::string_view key(str, length);
+            if (depth == 1) {
+                drawableId = parseIdKey(key, "DrawableID", filename, numericErrors, logger);
+            }
+            else if (depth == 2) {
+                textureId = parseIdKey(key, "TextureID", filename, numericErrors, logger);
+            }
+            else if (depth == 3) {
+                field = key == "GXT" ? Field::Gxt
+                      : key == "Localized" ? Field::Localized
+                      : Field::None;
+            }
+            return true;
+        }
+
+        bool String(const char* str, rapidjson::SizeType length, bool) {
+            if (arrayDepth == 0 && depth == 3) {
+                if (field == Field::Gxt) {
+                    current.GXT = strings.store(std::string_view(str, length));
+                }
+                else if (field == Field::Localized) {
+                    current.localized = strings.store(std::string_view(str, length));
+                }
+            }
+            field = Field::None;
+            return true;
+        }
+
+        bool EndObject(rapidjson::SizeType) {
+            if (arrayDepth == 0) {
+                if (depth == 3) {
+                    logger.log("Found item - DrawableID: " + std::to_string(current.drawableId) +
+                               ", TextureID: " + std::to_string(current.textureId) +
+                               ", GXT: " + std::string(current.GXT) +
+                               ", Localized: " + std::string(current.localized));
+                    items.push_back(current);
+                }
+                --depth;
+            }
+            return true;
+        }
+
+        bool StartArray() { ++arrayDepth; return true; }
+        bool EndArray(rapidjson::SizeType) { --arrayDepth; return true; }
+
+        // Any other scalar just consumes the pending key
+        bool Default() { field = Field::None; return true; }
+
+    private:
+        std::string_view filename;
+        std::string_view component;
+        Core::StringStore& strings;
+        std::vector<JsonItem>& items;
+        size_t& numericErrors;
+        Core::ILogger& logger;
+
+        int depth{0};
+        int arrayDepth{0};
+        Field field{Field::None};
+        int32_t drawableId{Core::Defaults::INVALID_ID};
+        int32_t textureId{Core::Defaults::INVALID_ID};
+        JsonItem current;
+    };
+}
+
+JsonParser::JsonParser(std::shared_ptr<Core::ILogger> logger, JsonParserOptions options)
     : logger(std::move(logger))
+    , options(options)
 {
 }
 
 bool JsonParser::parse() {
     try {
+        auto start = std::chrono::steady_clock::now();
         if (!scanDirectory(Core::FileConstants::JSON_DIR.data())) {
             logger->error("Failed to scan JSON directory");
             return false;
         }
 
-        for (const auto& path : filePaths) {
-            if (!loadJsonFile(path)) {
-                logger->error("Failed to load JSON file: " + path);
+        // Sorted paths make the item order independent of directory iteration order
+        auto byPath = [](const Core::ScannedFile& a, const Core::ScannedFile& b) { return a.path < b.path; };
+        std::sort(files.begin(), files.end(), byPath);
+
+        // Overlay layers follow the base in the order given, each sorted on its own so later layers win
+        size_t baseFileCount = files.size();
+        for (const auto& overlay : options.overlays) {
+            size_t layerStart = files.size();
+            if (!scanDirectory((std::filesystem::path(overlay) / Core::FileConstants::JSON_DIR).generic_string(), true)) {
+                logger->error("Failed to scan JSON overlay " + overlay);
                 return false;
             }
+            std::sort(files.begin() + layerStart, files.end(), byPath);
         }
 
-        if (!parseDocuments()) {
-            logger->error("Failed to parse JSON documents");
-            return false;
+        size_t females = Core::countGender(files, Core::InputGender::Female);
+        logger->log("Scanned " + std::to_string(files.size()) + " JSON files: " + std::to_string(females) +
+                    " female, " + std::to_string(files.size() - females) + " male or shared");
+
+        // Largest files first; the tops/undershirts/masks files dominate the stage
+        std::vector<size_t> order = Core::largestFirst(files);
+
+        unsigned threads = Core::resolveThreadCount(options.threadCount, files.size());
+        logger->log("Starting JSON document parsing on " + std::to_string(threads) + " thread(s)");
+
+        // Every file loads and extracts into its own slot; nothing shared is touched
+        std::vector<LoadedFile> loadedFiles(files.size());
+        std::vector<char> loaded(files.size(), 0);
+        Core::parallelFor(order, threads, [&](size_t i) {
+            loaded[i] = acquireFile(files[i].path, loadedFiles[i]);
+        });
+
+        for (size_t i = 0; i < loadedFiles.size(); ++i) {
+            if (!loaded[i]) {
+                logger->error("Failed to load JSON file: " + files[i].path);
+                return false;
+            }
+        }
+
+        size_t totalItems = 0;
+        for (const auto& file : loadedFiles) {
+            totalItems += file.items.size();
+        }
+        items.reserve(totalItems);
+
+        // Merge in sorted path order so getItems() matches a serial run exactly;
+        // enrichment takes the first GXT match, so order is observable. With overlays
+        // every item is indexed by file name and GXT as it is merged, and the k-th item
+        // with a GXT in an overlay file replaces the k-th one from the file of the same
+        // name in place (a GXT may repeat within a file).
+        std::unordered_map<std::string_view, std::unordered_map<std::string_view, std::vector<size_t>>> overlaySlots;
+        size_t invalidFiles = 0;
+        for (size_t i = 0; i < loadedFiles.size(); ++i) {
+            LoadedFile& file = loadedFiles[i];
+            bool validated = options.validation != JsonValidation::Off;
+            fileResults.push_back({ files[i].path, file.stamp, items.size(), file.items.size(), file.numericErrors,
+                                    validated, file.schemaErrors });
+            reusedFiles += file.reused ? 1 : 0;
+            if (file.schemaErrors > 0) {
+                ++invalidFiles;
+                schemaErrors += file.schemaErrors;
+                logger->error(files[i].path + ": " + std::to_string(file.schemaErrors) + " JSON schema violations" +
+                              (file.schemaError.empty() ? "" : ", first: " + file.schemaError));
+            }
+
+            if (options.overlays.empty()) {
+                items.insert(items.end(), file.items.begin(), file.items.end());
+            }
+            else {
+                bool overlay = i >= baseFileCount;
+                auto& fileIndex = overlaySlots[Core::inputFileName(files[i].path)];
+                std::unordered_map<std::string_view, size_t> occurrences;
+                for (const JsonItem& item : file.items) {
+                    if (item.GXT.empty()) {
+                        items.push_back(item);
+                        continue;
+                    }
+                    std::vector<size_t>& slots = fileIndex[item.GXT];
+                    size_t occurrence = occurrences[item.GXT]++;
+                    if (overlay && occurrence < slots.size()) {
+                        items[slots[occurrence]] = item;
+                        ++overriddenItems;
+                    }
+                    else {
+                        slots.push_back(items.size());
+                        items.push_back(item);
+                    }
+                }
+                fileResults.back().itemCount = items.size() - fileResults.back().firstItem;
+            }
+            numericErrors += file.numericErrors;
+            if (file.hasDocument) {
+                documents.push_back(std::move(file.document));
+            }
+            if (file.input.isOpen()) {
+                inputs.push_back(std::move(file.input));
+            }
+            if (file.strings.size() > 0) {
+                stringStores.push_back(std::move(file.strings));
+            }
+        }
+
+        buildGxtIndex();
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        logger->log("Successfully parsed " + std::to_string(items.size()) + " items (" +
+                    std::to_string(getGxtCount()) + " distinct GXTs) from JSON documents in " +
+                    std::to_string(elapsed.count()) + " ms");
+        if (!options.overlays.empty()) {
+            logger->log("JSON overlays: " + std::to_string(files.size() - baseFileCount) + " files, " +
+                        std::to_string(overriddenItems) + " items overridden by GXT");
+        }
+        if (snapshot) {
+            logger->log("JSON files: " + std::to_string(reusedFiles) + " reused from snapshot, " +
+                        std::to_string(files.size() - reusedFiles) + " re-parsed");
+        }
+        if (numericErrors > 0) {
+            logger->error(std::to_string(numericErrors) + " JSON drawable/texture IDs could not be parsed");
+        }
+        if (schemaErrors > 0) {
+            logger->error(std::to_string(schemaErrors) + " JSON schema violations in " + std::to_string(invalidFiles) +
+                          " files");
         }
 
         valid = true;
@@ -37,108 +391,240 @@ bool JsonParser::parse() {
     }
 }
 
-bool JsonParser::loadJsonFile(const std::string& path) {
-    std::ifstream ifs(path);
-    if (!ifs) {
+// Takes the file's items from the snapshot if it is unchanged, otherwise loads it;
+// only reads parser state, so it can run on any thread
+bool JsonParser::acquireFile(const std::string& path, LoadedFile& file) {
+    if (snapshot) {
+        // A file cached without validation, or with violations that must now fail, is re-parsed
+        auto* cached = snapshot->findJsonFile(path, file.stamp);
+        bool reusable = cached && (options.validation == JsonValidation::Off ||
+                                   (cached->validated && !(options.validation == JsonValidation::FailFast &&
+                                                           cached->schemaErrors > 0)));
+        if (reusable) {
+            file.items = std::move(cached->items);
+            file.numericErrors = cached->numericErrors;
+            file.schemaErrors = cached->schemaErrors;
+            file.reused = true;
+            return true;
+        }
+    }
+
+    if (!Core::readInputStamp(options.bundle.get(), path, file.stamp)) {
         return false;
     }
+    return loadFile(path, file);
+}
+
+// Loads one file and extracts its items; touches no parser state so it can run on any thread
+bool JsonParser::loadFile(const std::string& path, LoadedFile& file) {
+    switch (options.ingestMode) {
+    case JsonIngestMode::MemoryMapped:
+        return loadMappedJsonFile(path, file);
+    case JsonIngestMode::Sax:
+        return streamJsonFile(path, file);
+    default:
+        return loadJsonFile(path, file);
+    }
+}
+
+bool JsonParser::loadJsonFile(const std::string& path, LoadedFile& file) {
+    rapidjson::ParseResult result;
+    if (options.bundle || Core::Compression::hasCompressedSuffix(path)) {
+        // Strings are copied into the document, as they are when reading through a stream
+        Core::InputFile input;
+        std::string error;
+        if (!input.open(options.bundle.get(), path, Core::InputFile::Access::ReadOnly, error)) {
+            logger->error(error);
+            return false;
+        }
+        rapidjson::MemoryStream memory(input.data(), input.size());
+        rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> stream(memory);
+        result = populateValidated<rapidjson::kParseDefaultFlags>(file.document, stream, options.validation,
+                                                                  file.schemaErrors, file.schemaError);
+    }
+    else {
+        std::ifstream ifs(path);
+        if (!ifs) {
+            return false;
+        }
 
-    rapidjson::IStreamWrapper isw(ifs);
-    rapidjson::Document doc;
-    doc.ParseStream(isw);
+        rapidjson::IStreamWrapper isw(ifs);
+        result = populateValidated<rapidjson::kParseDefaultFlags>(file.document, isw, options.validation,
+                                                                  file.schemaErrors, file.schemaError);
+    }
 
-    if (doc.HasParseError()) {
+    if (!checkSchema(path, file) || result.IsError()) {
         return false;
     }
 
-    documents.push_back(std::move(doc));
+    file.hasDocument = true;
+    extractItems(file.document, path, file.items, file.numericErrors);
     return true;
 }
 
-bool JsonParser::scanDirectory(const std::string& directory) {
-    try {
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
-            if (entry.path().extension() == ".json") {
-                filePaths.push_back(entry.path().string());
-            }
-        }
-        return true;
+bool JsonParser::loadMappedJsonFile(const std::string& path, LoadedFile& file) {
+    // A bundle member or inflated buffer is writable too, and is kept with the documents
+    std::string error;
+    if (!file.input.open(options.bundle.get(), path, Core::InputFile::Access::CopyOnWrite, error)) {
+        logger->error(error);
+        return false;
     }
-    catch (const std::filesystem::filesystem_error& e) {
-        logger->error(std::string("Filesystem error: ") + e.what());
+
+    // In-situ parsing rewrites escapes and terminates strings inside the mapping,
+    // so every string in the DOM (names included) aliases the mapped pages
+    MappedInsituStream stream(file.input.data(), file.input.size());
+    rapidjson::ParseResult result = populateValidated<rapidjson::kParseInsituFlag>(
+        file.document, stream, options.validation, file.schemaErrors, file.schemaError);
+
+    if (!checkSchema(path, file) || result.IsError()) {
         return false;
     }
-}
 
-std::string_view JsonParser::getComponentType(const std::string_view& filename) {
-    // Return the short component types that match our constants
-    if (filename.find("accessories") != std::string_view::npos) return "ACCS";
-    if (filename.find("hair") != std::string_view::npos) return "HAIR";
-    if (filename.find("legs") != std::string_view::npos) return "LEGS";
-    if (filename.find("shoes") != std::string_view::npos) return "FEET";
-    if (filename.find("tops") != std::string_view::npos) return "JBIB";        // Torso 2
-    if (filename.find("torsos") != std::string_view::npos) return "TORSO";     // Gloves/Arms
-    if (filename.find("undershirts") != std::string_view::npos) return "ACCS"; // Torso 1
-    if (filename.find("bracelets") != std::string_view::npos) return "WRIST";
-    if (filename.find("ears") != std::string_view::npos) return "TEETH";       // Accessories
-    if (filename.find("glasses") != std::string_view::npos) return "PEYES";
-    if (filename.find("hats") != std::string_view::npos) return "PHEAD";
-    if (filename.find("watch") != std::string_view::npos) return "WRIST";
-    if (filename.find("mask") != std::string_view::npos) return "BERD";
-    return "UNKNOWN";
+    file.hasDocument = true;
+    extractItems(file.document, path, file.items, file.numericErrors);
+    return true;
 }
 
-bool JsonParser::parseDocuments() {
-    try {
-        logger->log("Starting JSON document parsing");
-        
-        for (size_t i = 0; i < documents.size(); ++i) {
-            const auto& doc = documents[i];
-            std::string_view filename = filePaths[i];
-            std::string_view componentType = getComponentType(filename);
-            
-            logger->log("Parsing file: " + std::string(filename));
-            logger->log("Component type: " + std::string(componentType));
-
-            // Iterate through drawable IDs
-            for (auto drawableIt = doc.MemberBegin(); drawableIt != doc.MemberEnd(); ++drawableIt) {
-                std::string drawableId = drawableIt->name.GetString();
-                
-                // Iterate through texture IDs
-                for (auto textureIt = drawableIt->value.MemberBegin(); 
-                     textureIt != drawableIt->value.MemberEnd(); 
-                     ++textureIt) {
-                    
-                    JsonItem item;
-                    item.filename = filename;
-                    item.component = componentType;
-                    //item.drawableId = drawableId;
-                    item.drawableId = drawableIt->name.GetString();
-                    item.textureId = textureIt->name.GetString();
-                    
-                    // Get GXT and Localized values
-                    if (textureIt->value.HasMember("GXT")) {
-                        item.GXT = textureIt->value["GXT"].GetString();
-                    }
-                    if (textureIt->value.HasMember("Localized")) {
-                        item.localized = textureIt->value["Localized"].GetString();
-                    }
+bool JsonParser::streamJsonFile(const std::string& path, LoadedFile& file) {
+    // Read-only mapping: pages stay shared with the page cache and are released
+    // (as is an inflated buffer) as soon as this file has been streamed
+    Core::InputFile input;
+    std::string error;
+    if (!input.open(options.bundle.get(), path, Core::InputFile::Access::ReadOnly, error)) {
+        logger->error(error);
+        return false;
+    }
+    std::string_view content = input.view();
 
-                    logger->log("Found item - DrawableID: " + std::string(item.drawableId) +
-                                ", TextureID: " + std::string(item.textureId) + 
-                                ", GXT: " + std::string(item.GXT) + 
-                                ", Localized: " + std::string(item.localized));
+    std::string_view filename = Core::intern(path);
+    std::string_view componentType = Core::inputComponent(filename);
 
-                    items.push_back(std::move(item));
-                }
-            }
+    logger->log("Parsing file: " + path);
+    logger->log("Component type: " + std::string(componentType));
+
+    // Parsing, validation and item extraction happen in the same pass; no DOM is built
+    rapidjson::MemoryStream stream(content.data(), content.size());
+    JsonItemHandler handler(filename, componentType, file.strings, file.items, file.numericErrors, *logger);
+    rapidjson::ParseResult result = parseValidated<rapidjson::kParseDefaultFlags>(
+        stream, handler, options.validation, file.schemaErrors, file.schemaError);
+
+    if (!checkSchema(path, file)) {
+        return false;
+    }
+    if (!result) {
+        logger->error("JSON parse error in " + path + " at offset " + std::to_string(result.Offset()) +
+                      ": " + rapidjson::GetParseError_En(result.Code()));
+        return false;
+    }
+    return true;
+}
+
+void JsonParser::buildGxtIndex() {
+    gxtIndex.clear();
+    gxtIndex.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        const JsonItem& item = items[i];
+        if (item.GXT.empty() || item.GXT == Core::Defaults::NO_LABEL) {
+            continue;
+        }
+        GxtEntry& entry = gxtIndex[item.GXT];
+        if (entry.first == NO_ITEM) {
+            entry.first = static_cast<uint32_t>(i);
+        }
+        bool named = !item.localized.empty() && item.localized != Core::Defaults::NULL_NAME &&
+                     item.localized != Core::Defaults::NO_LABEL;
+        if (named && entry.named == NO_ITEM) {
+            entry.named = static_cast<uint32_t>(i);
         }
+    }
+}
 
-        logger->log("Successfully parsed " + std::to_string(items.size()) + " items from JSON documents");
+const JsonItem* JsonParser::findByGxt(std::string_view gxt) const {
+    auto it = gxtIndex.find(gxt);
+    return it != gxtIndex.end() ? &items[it->second.first] : nullptr;
+}
+
+const JsonItem* JsonParser::findNamedByGxt(std::string_view gxt) const {
+    auto it = gxtIndex.find(gxt);
+    return it != gxtIndex.end() && it->second.named != NO_ITEM ? &items[it->second.named] : nullptr;
+}
+
+// Fails the file on a violation in FailFast mode; otherwise the count travels with its items
+bool JsonParser::checkSchema(const std::string& path, const LoadedFile& file) {
+    if (options.validation == JsonValidation::FailFast && file.schemaErrors > 0) {
+        logger->error("JSON schema violation in " + path + ": " + file.schemaError);
+        return false;
+    }
+    return true;
+}
+
+// Overlays are always read from disk; the base comes from the bundle when there is one
+bool JsonParser::scanDirectory(const std::string& directory, bool overlay) {
+    // An overlay may carry only shop meta or only JSON files
+    std::error_code ec;
+    if (overlay && !std::filesystem::is_directory(directory, ec)) {
         return true;
     }
-    catch (const std::exception& e) {
-        logger->error("Exception in parseDocuments: " + std::string(e.what()));
+
+    // Archive order stands in for directory iteration order
+    std::string error;
+    if (!Core::scanInputs(overlay ? nullptr : options.bundle.get(), directory, ".json", files, error)) {
+        logger->error(error);
         return false;
     }
-} 
\ No newline at end of file
+    return true;
+}
+
+void JsonParser::extractItems(const rapidjson::Document& doc, std::string_view filename,
+                              std::vector<JsonItem>& out, size_t& numericErrors) {
+    filename = Core::intern(filename);  // Items outlive files reallocation this way
+    std::string_view componentType = Core::inputComponent(filename);
+
+    logger->log("Parsing file: " + std::string(filename));
+    logger->log("Component type: " + std::string(componentType));
+
+    // Values of the wrong type are skipped or left empty, as the SAX handler does
+    if (!doc.IsObject()) {
+        return;
+    }
+
+    // Iterate through drawable IDs
+    for (auto drawableIt = doc.MemberBegin(); drawableIt != doc.MemberEnd(); ++drawableIt) {
+        int32_t drawableId = parseIdKey(toView(drawableIt->name), "DrawableID", filename, numericErrors, *logger);
+        if (!drawableIt->value.IsObject()) {
+            continue;
+        }
+
+        // Iterate through texture IDs
+        for (auto textureIt = drawableIt->value.MemberBegin(); 
+             textureIt != drawableIt->value.MemberEnd(); 
+             ++textureIt) {
+            
+            JsonItem item;
+            item.filename = filename;
+            item.component = componentType;
+            item.drawableId = drawableId;
+            item.textureId = parseIdKey(toView(textureIt->name), "TextureID", filename, numericErrors, *logger);
+            if (!textureIt->value.IsObject()) {
+                continue;
+            }
+
+            // Get GXT and Localized values
+            auto gxtIt = textureIt->value.FindMember("GXT");
+            if (gxtIt != textureIt->value.MemberEnd() && gxtIt->value.IsString()) {
+                item.GXT = toView(gxtIt->value);
+            }
+            auto localizedIt = textureIt->value.FindMember("Localized");
+            if (localizedIt != textureIt->value.MemberEnd() && localizedIt->value.IsString()) {
+                item.localized = toView(localizedIt->value);
+            }
+
+            logger->log("Found item - DrawableID: " + std::to_string(item.drawableId) +
+                        ", TextureID: " + std::to_string(item.textureId) + 
+                        ", GXT: " + std::string(item.GXT) + 
+                        ", Localized: " + std::string(item.localized));
+
+            out.push_back(std::move(item));
+        }
+    }
+}
@@ -1,41 +1,135 @@
 #pragma once
 #include "../Core/Interfaces.h"
+#include "../Core/Constants.h"
+#include "../Core/FileScanner.h"
+#include "../Core/FileStamp.h"
+#include "../Core/InputFile.h"
+#include "../Core/StringStore.h"
+#include "../Core/TarBundle.h"
 #include "rapidjson/document.h"
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
+class CorpusSnapshot;
+
 struct JsonItem {
     std::string_view filename;
     //std::string_view dlcName;
-    std::string_view drawableId;
-    std::string_view textureId;
+    int32_t drawableId{Core::Defaults::INVALID_ID};  // Parsed at ingest
+    int32_t textureId{Core::Defaults::INVALID_ID};
     std::string_view GXT;
     std::string_view localized;
     std::string_view component;  // Type of item (accessories, hair, legs, etc.)
 };
 
+// How JSON files are brought into memory before parsing
+enum class JsonIngestMode {
+    Stream,        // std::ifstream + IStreamWrapper, every string copied into the DOM
+    MemoryMapped,  // Copy-on-write mapping parsed in situ, strings point into the mapping
+    Sax            // Read-only mapping streamed through rapidjson::Reader, no DOM retained
+};
+
+// Checking each file against the bundled item schema, done by the parsing pass itself
+enum class JsonValidation {
+    Off,       // Items are extracted as found; a missing GXT or a non-string Localized becomes empty
+    Report,    // Violations are counted and logged per file, the items are still extracted
+    FailFast   // The first violation stops that file and fails the parse
+};
+
+struct JsonParserOptions {
+    JsonIngestMode ingestMode{JsonIngestMode::Stream};
+    JsonValidation validation{JsonValidation::Report};
+    unsigned threadCount{1};  // Worker threads for load + extraction, 0 = one per core
+    std::shared_ptr<Core::TarBundle> bundle;  // Read Jsonfiles/ members from this archive instead of the disk
+    std::vector<std::string> overlays;  // Directories whose Jsonfiles/ override same-named files' items by GXT, in order
+};
+
 class JsonParser : public Core::IParser {
 private:
     std::shared_ptr<Core::ILogger> logger;
-    std::vector<std::string> filePaths;
+    JsonParserOptions options;
+    std::vector<Core::ScannedFile> files;  // Sorted by path within each layer, base layer first, then each overlay
+    std::vector<Core::InputFile> inputs;  // Backing storage for in-situ documents
     std::vector<rapidjson::Document> documents;
+    std::vector<Core::StringStore> stringStores;  // Own the item strings in Sax mode
     std::vector<JsonItem> items;
+    size_t numericErrors{0};  // Drawable/texture keys that were not valid integers
+    size_t schemaErrors{0};   // Schema violations over all files
+    std::shared_ptr<CorpusSnapshot> snapshot;  // Previous run's results; owns the strings of reused items
+    size_t reusedFiles{0};
+    size_t overriddenItems{0};
     bool valid{false};
 
-    // Helper method to determine component type from filename
-    std::string_view getComponentType(const std::string_view& filename);
+    // Every GXT in items, built once parse() has merged all files and overlays; rows
+    // labelled NO_LABEL (or without a GXT) are left out, as no lookup can want them
+    static constexpr uint32_t NO_ITEM = UINT32_MAX;
+    struct GxtEntry {
+        uint32_t first{NO_ITEM};  // Position in items of the first row with the GXT
+        uint32_t named{NO_ITEM};  // ... and of the first one whose localized name is usable
+    };
+    std::unordered_map<std::string_view, GxtEntry> gxtIndex;
+
+    // Everything one file contributes, filled independently so files can load concurrently
+    struct LoadedFile {
+        Core::InputFile input;
+        rapidjson::Document document;
+        Core::StringStore strings;
+        std::vector<JsonItem> items;
+        size_t numericErrors{0};
+        size_t schemaErrors{0};
+        std::string schemaError;  // The first violation, for the log
+        bool hasDocument{false};
+        Core::FileStamp stamp;
+        bool reused{false};  // Items came from the snapshot, the file was not read
+    };
 
 public:
-    explicit JsonParser(std::shared_ptr<Core::ILogger> logger);
+    explicit JsonParser(std::shared_ptr<Core::ILogger> logger, JsonParserOptions options = {});
     
     bool parse() override;
     bool isValid() const override { return valid; }
+
+    // Reuse a previous run's items for files that have not changed since; call before parse()
+    void reuseFrom(std::shared_ptr<CorpusSnapshot> snapshot) { this->snapshot = std::move(snapshot); }
     
     const std::vector<JsonItem>& getItems() const { return items; }
-    const std::vector<rapidjson::Document>& getDocuments() const { return documents; }
+    const std::vector<rapidjson::Document>& getDocuments() const { return documents; }  // Empty in Sax mode
+    size_t getNumericErrorCount() const { return numericErrors; }
+    size_t getSchemaErrorCount() const { return schemaErrors; }
+
+    // First item with `gxt`, or nullptr
+    const JsonItem* findByGxt(std::string_view gxt) const;
+    // First item with `gxt` whose localized name is neither empty nor NULL/NO_LABEL, or nullptr
+    const JsonItem* findNamedByGxt(std::string_view gxt) const;
+    size_t getGxtCount() const { return gxtIndex.size(); }
+
+    // Where each input file's items ended up in getItems(), for the snapshot writer
+    struct FileResult {
+        std::string path;
+        Core::FileStamp stamp;
+        size_t firstItem{0};
+        size_t itemCount{0};
+        size_t numericErrors{0};
+        bool validated{false};  // schemaErrors is meaningful
+        size_t schemaErrors{0};
+    };
+    const std::vector<FileResult>& getFileResults() const { return fileResults; }
+    size_t getReusedFileCount() const { return reusedFiles; }
+    size_t getOverriddenItemCount() const { return overriddenItems; }
 
 private:
-    bool loadJsonFile(const std::string& path);
-    bool scanDirectory(const std::string& directory);
-    bool parseDocuments();
+    std::vector<FileResult> fileResults;
+
+    bool acquireFile(const std::string& path, LoadedFile& file);
+    bool loadFile(const std::string& path, LoadedFile& file);
+    bool loadJsonFile(const std::string& path, LoadedFile& file);
+    bool loadMappedJsonFile(const std::string& path, LoadedFile& file);
+    bool streamJsonFile(const std::string& path, LoadedFile& file);
+    bool checkSchema(const std::string& path, const LoadedFile& file);
+    void buildGxtIndex();
+    bool scanDirectory(const std::string& directory, bool overlay = false);
+    void extractItems(const rapidjson::Document& doc, std::string_view filename, std::vector<JsonItem>& out,
+                      size_t& numericErrors);
 }; 
\ No newline at end of file
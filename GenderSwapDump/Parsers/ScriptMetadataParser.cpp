@@ -1,19 +1,59 @@
 #include "ScriptMetadataParser.h"
+#include "../Core/ComponentClassifier.h"
 #include "../Core/Constants.h"
+#include "../Core/StringPool.h"
+#include "CorpusSnapshot.h"
+#include <algorithm>
+#include <chrono>
 
-ScriptMetadataParser::ScriptMetadataParser(std::shared_ptr<Core::ILogger> logger)
+ScriptMetadataParser::ScriptMetadataParser(std::shared_ptr<Core::ILogger> logger, ScriptMetadataParserOptions options)
     : logger(std::move(logger))
+    , options(options)
 {
 }
 
 bool ScriptMetadataParser::parse() {
     try {
-        auto result = doc.load_file(Core::FileConstants::SCRIPT_METADATA.data(),
-                                  pugi::parse_default | pugi::parse_declaration);
+        sourcePath = Core::resolveInputPath(options.bundle.get(), std::string(Core::FileConstants::SCRIPT_METADATA));
+        if (snapshot) {
+            if (auto* cached = snapshot->findScriptFile(sourcePath, sourceStamp)) {
+                parsedData.maleItems = std::move(cached->maleItems);
+                parsedData.femaleItems = std::move(cached->femaleItems);
+                if (options.dlcs) {
+                    for (auto* items : { &parsedData.maleItems, &parsedData.femaleItems }) {
+                        items->erase(std::remove_if(items->begin(), items->end(),
+                                                    [this](const Core::ClothingItem& item) { return !isSelected(item); }),
+                                     items->end());
+                    }
+                }
+                logger->log("Script metadata reused from snapshot");
+                reused = true;
+                valid = true;
+                return true;
+            }
+        }
+
+        // A missing file is reported by the load below
+        Core::readInputStamp(options.bundle.get(), sourcePath, sourceStamp);
+
+        if (options.ingestMode == XmlIngestMode::Pull) {
+            if (!streamScriptMetadata()) {
+                return false;
+            }
+
+            valid = true;
+            return true;
+        }
+
+        // Only element names and attributes are read, so comments, PCDATA end-of-line
+        // handling and the declaration node are not worth building
+        std::string error;
+        auto result = loadXmlDocument(doc, input, options.bundle.get(), sourcePath, options.ingestMode,
+                                      pugi::parse_escapes, error);
         
         if (!result) {
             logger->error("Failed to parse script metadata: " + 
-                         std::string(result.description()));
+                         (error.empty() ? std::string(result.description()) : error));
             return false;
         }
 
@@ -45,26 +85,182 @@ bool ScriptMetadataParser::parseScriptMetadata() {
         for (pugi::xml_node item = gender.child("Item");
              item; item = item.next_sibling())
         {
-            Core::ClothingItem clothingItem;
-            
             // Parse attributes
             pugi::xml_attribute attr = item.first_attribute();
-            clothingItem.m_key = attr.value();
+            std::string_view key = attr.value();
             attr = attr.next_attribute();
-            clothingItem.value = attr.value();
+            addItem(key, attr.value());
+        }
+    }
+    return true;
+}
+
+// Pull mode: only MPApparelData is tokenized past its start tag, key/value pairs are
+// copied into `strings` and the mapping is released before returning
+bool ScriptMetadataParser::streamScriptMetadata() {
+    auto start = std::chrono::steady_clock::now();
+
+    Core::InputFile file;
+    std::string error;
+    if (!file.open(options.bundle.get(), sourcePath, Core::InputFile::Access::ReadOnly, error)) {
+        logger->error("Failed to parse script metadata: " + error);
+        return false;
+    }
+    std::string_view content = file.view();
+
+    XmlPullReader reader(content.data(), content.size());
+    XmlPullReader::Event event;
+    do {
+        event = reader.next();
+    } while (event == XmlPullReader::Event::Text || event == XmlPullReader::Event::Comment);
+
+    bool found = false;
+    if (event == XmlPullReader::Event::StartElement && !reader.isEmptyElement()) {
+        while ((event = reader.next()) != XmlPullReader::Event::EndElement) {
+            if (event == XmlPullReader::Event::Error || event == XmlPullReader::Event::EndOfDocument) {
+                break;
+            }
+            if (event != XmlPullReader::Event::StartElement) {
+                continue;
+            }
+
+            if (reader.name() == "MPApparelData") {
+                // Nothing after it is needed, so the rest of the file is never read
+                found = true;
+                if (!reader.isEmptyElement() && !streamApparelData(reader)) {
+                    event = XmlPullReader::Event::Error;
+                }
+                break;
+            }
+            if (!reader.skipElement()) {
+                event = XmlPullReader::Event::Error;
+                break;
+            }
+        }
+    }
+
+    if (event == XmlPullReader::Event::Error) {
+        logger->error("Failed to parse script metadata: " + std::string(reader.errorMessage()) +
+                      " at offset " + std::to_string(reader.errorOffset()));
+        return false;
+    }
+    if (!found) {
+        logger->error("Failed to find MPApparelData node");
+        return false;
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    logger->log("Script metadata streamed: " +
+                std::to_string(parsedData.maleItems.size() + parsedData.femaleItems.size()) + " items, " +
+                std::to_string(strings.size()) + " bytes kept of " + std::to_string(content.size()) +
+                " in " + std::to_string(elapsed.count()) + " ms");
+    return true;
+}
+
+// Mirrors parseScriptMetadata: genders start at the first MPApparelDataMale and items at
+// each gender's first Item, after which every sibling element counts
+bool ScriptMetadataParser::streamApparelData(XmlPullReader& reader) {
+    using Event = XmlPullReader::Event;
+
+    // decode() only copies when it had to rewrite the text; everything must outlive the mapping
+    auto ownedCopy = [this](std::string_view raw) {
+        std::string_view decoded = XmlPullReader::decode(raw, strings);
+        return decoded.data() == raw.data() ? strings.store(raw) : decoded;
+    };
 
-            // Determine component and DLC type
-            determineComponentType(clothingItem);
-            determineDlcType(clothingItem);
+    bool inGenders = false;
+    Event event;
+    while ((event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+        if (event != Event::StartElement) {
+            continue;
+        }
 
-            // Categorize by gender
-            categorizeItem(clothingItem);
+        inGenders = inGenders || reader.name() == "MPApparelDataMale";
+        if (!inGenders || reader.isEmptyElement()) {
+            if (!reader.skipElement()) {
+                return false;
+            }
+            continue;
+        }
+
+        bool inItems = false;
+        while ((event = reader.next()) != Event::EndElement) {
+            if (event == Event::Error || event == Event::EndOfDocument) {
+                return false;
+            }
+            if (event != Event::StartElement) {
+                continue;
+            }
+
+            inItems = inItems || reader.name() == "Item";
+            if (inItems) {
+                // Attributes are positional: the first is the key, the second the value
+                size_t cursor = 0;
+                std::string_view name;
+                std::string_view key;
+                std::string_view value;
+                if (reader.nextAttribute(cursor, name, key)) {
+                    reader.nextAttribute(cursor, name, value);
+                }
+                addItem(ownedCopy(key), ownedCopy(value));
+            }
+            if (!reader.skipElement()) {
+                return false;
+            }
         }
     }
     return true;
 }
 
+size_t ScriptMetadataParser::compact() {
+    // Pull mode already copied keys and values into `strings`; they move to a fresh
+    // store along with everything else so the old one can be dropped too
+    Core::StringStore owned;
+    for (auto* items : { &parsedData.maleItems, &parsedData.femaleItems }) {
+        for (Core::ClothingItem& item : *items) {
+            item.m_key = owned.store(item.m_key);
+            item.value = owned.store(item.value);
+        }
+    }
+
+    MPApparelData = pugi::xml_node();
+    doc.reset();
+    input.close();
+    strings = std::move(owned);
+    snapshot.reset();
+
+    logger->log("Compacted script metadata: " + std::to_string(strings.size()) + " bytes kept");
+    return strings.size();
+}
+
+void ScriptMetadataParser::addItem(std::string_view key, std::string_view value) {
+    Core::ClothingItem clothingItem;
+    clothingItem.m_key = key;
+    clothingItem.value = value;
+
+    // Determine component and DLC type
+    determineComponentType(clothingItem);
+    determineDlcType(clothingItem);
+
+    // Categorize by gender
+    categorizeItem(clothingItem);
+}
+
+// An item belongs to the selection through its own DLC, the item it pairs with, or a
+// key the XmlParser found in the shop meta files it loaded for the selection
+bool ScriptMetadataParser::isSelected(const Core::ClothingItem& item) const {
+    return !options.dlcs || options.dlcs->contains(item.dlc) ||
+           options.dlcs->mentionedIn(item.m_key) || options.dlcs->mentionedIn(item.value) ||
+           options.dlcs->isRelatedKey(item.m_key);
+}
+
 void ScriptMetadataParser::categorizeItem(Core::ClothingItem& item) {
+    if (!isSelected(item)) {
+        return;
+    }
     if (item.m_key.find(Core::GenderIdentifiers::MALE_PREFIX) != std::string_view::npos) {
         item.m_gender = Core::GenderIdentifiers::MALE_STR;
         parsedData.maleItems.push_back(item);
@@ -76,21 +272,15 @@ void ScriptMetadataParser::categorizeItem(Core::ClothingItem& item) {
 }
 
 void ScriptMetadataParser::determineComponentType(Core::ClothingItem& item) {
-    for (const auto& comp : Core::ComponentTypes::UNIFIED_COMPONENTS) {
-        if (item.m_key.find(comp.legacyInFiles) != std::string_view::npos) {
-            item.comp = comp.displayName;
-            break;
-        }
+    if (const auto* comp = Core::ComponentClassifier::instance().classifyKey(item.m_key)) {
+        item.comp = Core::ComponentTypes::componentId(*comp);
     }
 }
 
 void ScriptMetadataParser::determineDlcType(Core::ClothingItem& item) {
-    for (const auto& dlc : Core::DlcInfo::DLC_LIST) {
-        if (item.m_key.find(dlc.dlc_key) != std::string_view::npos) {
-            //logger->log("[determineDlcType] : " + std::string(item.m_key) + " : " + std::string(dlc.dlc_key) + " : " + std::string(dlc.name));
-            item.dlcName = dlc.name;
-            return;
-        }
+    if (const auto* dlc = Core::ComponentUtils::matchDlcKey(item.m_key)) {
+        item.dlc = Core::DlcInfo::dlcId(*dlc);
+        return;
     }
 
     logger->log("[determineDlcType] FAILED : " + std::string(item.m_key));
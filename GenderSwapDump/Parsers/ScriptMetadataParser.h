@@ -1,13 +1,36 @@
 #pragma once
 #include "../Core/Interfaces.h"
 #include "../Models/ClothingTypes.h"
+#include "../Core/DlcSelection.h"
+#include "../Core/FileStamp.h"
+#include "../Core/InputFile.h"
+#include "../Core/StringStore.h"
+#include "../Core/TarBundle.h"
+#include "XmlDocumentLoader.h"
+#include "XmlPullReader.h"
 #include "pugixml/pugixml.hpp"
 #include <memory>
+#include <string>
+
+class CorpusSnapshot;
+
+struct ScriptMetadataParserOptions {
+    XmlIngestMode ingestMode{XmlIngestMode::File};
+    std::shared_ptr<Core::TarBundle> bundle;  // Used when it contains scriptmetadata.meta[.gz], else the disk file is read
+    std::shared_ptr<const Core::DlcSelection> dlcs;  // Keep only the items of these DLCs, their pairs and related keys; parse after XmlParser
+};
 
 class ScriptMetadataParser : public Core::IParser {
 private:
     std::shared_ptr<Core::ILogger> logger;
-    pugi::xml_document doc;
+    ScriptMetadataParserOptions options;
+    Core::InputFile input;     // Declared before doc so it outlives an in-place document
+    pugi::xml_document doc;    // Unused in Pull mode
+    Core::StringStore strings; // Owns the key/value text in Pull mode and after compact()
+    std::shared_ptr<CorpusSnapshot> snapshot;  // Previous run's results; owns the text of reused items
+    std::string sourcePath;  // scriptmetadata.meta, or its compressed copy when only that exists
+    Core::FileStamp sourceStamp;
+    bool reused{false};
     pugi::xml_node MPApparelData;
     bool valid{false};
 
@@ -17,17 +40,31 @@ private:
     } parsedData;
 
 public:
-    explicit ScriptMetadataParser(std::shared_ptr<Core::ILogger> logger);
+    explicit ScriptMetadataParser(std::shared_ptr<Core::ILogger> logger, ScriptMetadataParserOptions options = {});
     
     bool parse() override;
     bool isValid() const override { return valid; }
+
+    // Reuse a previous run's items if the file has not changed since; call before parse()
+    void reuseFrom(std::shared_ptr<CorpusSnapshot> snapshot) { this->snapshot = std::move(snapshot); }
     
     const std::vector<Core::ClothingItem>& getMaleItems() const { return parsedData.maleItems; }
     const std::vector<Core::ClothingItem>& getFemaleItems() const { return parsedData.femaleItems; }
+    const std::string& getSourcePath() const { return sourcePath; }
+    const Core::FileStamp& getSourceStamp() const { return sourceStamp; }
+    bool wasReused() const { return reused; }
+
+    // Copy item keys and values into `strings` and free the document, mapping and
+    // snapshot they pointed into; returns the bytes kept. Call after parse().
+    size_t compact();
 
 private:
     bool parseScriptMetadata();
+    bool streamScriptMetadata();
+    bool streamApparelData(XmlPullReader& reader);
+    void addItem(std::string_view key, std::string_view value);
     void categorizeItem(Core::ClothingItem& item);
+    bool isSelected(const Core::ClothingItem& item) const;
     void determineComponentType(Core::ClothingItem& item);
     void determineDlcType(Core::ClothingItem& item);
 }; 
\ No newline at end of file
@@ -0,0 +1,477 @@
+#include "ShopMetaExtractor.h"
+#include "../Core/Constants.h"
+#include "../Core/StringPool.h"
+#include "ShopMetaFields.h"
+
+namespace {
+    using Event = XmlPullReader::Event;
+
+    // Bits for "field already read": pugixml's child() returns the first match,
+    // so a repeated tag must not overwrite the value taken from the first one
+    enum FieldBit : unsigned {
+        LockHash = 1u << 0,
+        TextLabel = 1u << 1,
+        UniqueNameHash = 1u << 2,
+        Index = 1u << 3,
+        TextureIndex = 1u << 4,
+        TypeTag = 1u << 5,
+        IncludedComponents = 1u << 6,
+        IncludedProps = 1u << 7,
+        PedName = 1u << 8,
+        DlcName = 1u << 9,
+        FullDlcName = 1u << 10,
+        Outfits = 1u << 11,
+        Components = 1u << 12,
+        Props = 1u << 13,
+        Cost = 1u << 14,
+        DrawableIndex = 1u << 15,
+        ShopEnum = 1u << 16,
+        RestrictionTags = 1u << 17,
+        ForcedComponents = 1u << 18,
+        VariantComponents = 1u << 19
+    };
+
+    bool firstOf(unsigned& seen, FieldBit bit) {
+        if (seen & bit) {
+            return false;
+        }
+        seen |= bit;
+        return true;
+    }
+}
+
+ShopMetaExtractor::ShopMetaExtractor(std::shared_ptr<Core::ILogger> logger, Core::StringStore& strings,
+                                     size_t& numericErrors)
+    : logger(std::move(logger))
+    , strings(strings)
+    , numericErrors(numericErrors)
+{
+}
+
+bool ShopMetaExtractor::extract(std::string_view buffer, XmlNode& node) {
+    XmlPullReader reader(buffer.data(), buffer.size());
+
+    // Find the document element
+    Event event;
+    do {
+        event = reader.next();
+    } while (event == Event::Text || event == Event::Comment);
+
+    if (event != Event::StartElement) {
+        if (event == Event::Error) {
+            return fail(reader);
+        }
+        error = "no document element";
+        errorAt = reader.offset();
+        return false;
+    }
+    if (reader.isEmptyElement()) {
+        return true;
+    }
+
+    logger->log("Parsing XML node...");
+
+    unsigned seen = 0;
+    while ((event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return fail(reader);
+        }
+        if (event != Event::StartElement) {
+            continue;
+        }
+
+        std::string_view tag = reader.name();
+        bool ok = true;
+        if (tag == "pedName" && firstOf(seen, PedName)) {
+            ok = readInterned(reader, node.pedName);
+            logger->log("Found pedName: " + std::string(node.pedName));
+        }
+        else if (tag == "dlcName" && firstOf(seen, DlcName)) {
+            ok = readInterned(reader, node.dlcName);
+            logger->log("Found dlcName: " + std::string(node.dlcName));
+        }
+        else if (tag == "fullDlcName" && firstOf(seen, FullDlcName)) {
+            ok = readInterned(reader, node.fullDlcName);
+            logger->log("Found fullDlcName: " + std::string(node.fullDlcName));
+        }
+        else if (tag == "pedOutfits" && firstOf(seen, Outfits)) {
+            ok = reader.isEmptyElement() || parseOutfits(reader, node);
+        }
+        else if (tag == "pedComponents" && firstOf(seen, Components)) {
+            ok = reader.isEmptyElement() || parseItems(reader, node, false);
+        }
+        else if (tag == "pedProps" && firstOf(seen, Props)) {
+            ok = reader.isEmptyElement() || parseItems(reader, node, true);
+        }
+        else {
+            ok = reader.skipElement();
+        }
+
+        if (!ok) {
+            return fail(reader);
+        }
+    }
+
+    logger->log("Successfully parsed XML node with " +
+                std::to_string(node.outfits.size()) + " outfits and " +
+                std::to_string(node.items.size()) + " individual items");
+    return true;
+}
+
+// Value of the first text child of the element just started, consuming the element
+bool ShopMetaExtractor::readText(XmlPullReader& reader, std::string_view& out) {
+    if (reader.isEmptyElement()) {
+        out = std::string_view();
+        return true;
+    }
+
+    size_t depth = reader.depth();
+    bool found = false;
+    out = std::string_view();
+    while (true) {
+        Event event = reader.next();
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+        if (event == Event::Text && !found && reader.depth() == depth) {
+            // CDATA skips entity expansion, but pugixml still normalises its line endings
+            out = XmlPullReader::decode(reader.value(), strings, !reader.isCData());
+            found = true;
+        }
+        else if (event == Event::EndElement && reader.depth() < depth) {
+            return true;
+        }
+    }
+}
+
+// readText for the low-cardinality fields (DLC names, lock hashes, component types),
+// which go through the global pool so every item shares one copy
+bool ShopMetaExtractor::readInterned(XmlPullReader& reader, std::string_view& out) {
+    if (!readText(reader, out)) {
+        return false;
+    }
+    out = Core::intern(out);
+    return true;
+}
+
+bool ShopMetaExtractor::parseOutfits(XmlPullReader& reader, XmlNode& node) {
+    logger->log("Parsing pedOutfits...");
+    std::string_view currentOutfitName = Core::Defaults::NA;
+
+    Event event;
+    while ((event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+
+        if (event == Event::Comment) {
+            currentOutfitName = XmlPullReader::decode(reader.value(), strings, false);
+            logger->log("Found outfit comment: " + std::string(currentOutfitName));
+        }
+        else if (event == Event::StartElement) {
+            if (reader.name() != "Item") {
+                if (!reader.skipElement()) {
+                    return false;
+                }
+                continue;
+            }
+
+            XmlOutfit outfit;
+            outfit.outfitName = currentOutfitName;
+            if (!reader.isEmptyElement() && !parseOutfit(reader, outfit)) {
+                return false;
+            }
+
+            logger->log("Found outfit: " + std::string(outfit.outfitName) +
+                        ", Hash: " + std::string(outfit.uniqueNameHash) +
+                        ", Components: " + std::to_string(outfit.components.size()) +
+                        ", Props: " + std::to_string(outfit.props.size()));
+
+            node.outfits.push_back(std::move(outfit));
+            currentOutfitName = Core::Defaults::NA;  // Reset outfit name after use
+        }
+    }
+    return true;
+}
+
+bool ShopMetaExtractor::parseOutfit(XmlPullReader& reader, XmlOutfit& outfit) {
+    unsigned seen = 0;
+    Event event;
+    while ((event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+        if (event != Event::StartElement) {
+            continue;
+        }
+
+        std::string_view tag = reader.name();
+        bool ok = true;
+        if (tag == "lockHash" && firstOf(seen, LockHash)) {
+            ok = readInterned(reader, outfit.lockHash);
+        }
+        else if (tag == "textLabel" && firstOf(seen, TextLabel)) {
+            ok = readText(reader, outfit.textLabel);
+        }
+        else if (tag == "uniqueNameHash" && firstOf(seen, UniqueNameHash)) {
+            ok = readText(reader, outfit.uniqueNameHash);
+        }
+        else if (tag == "includedPedComponents" && firstOf(seen, IncludedComponents)) {
+            ok = reader.isEmptyElement() ||
+                 parseIncludedItems(reader, outfit.components, "eCompType", &XmlItem::eCompType);
+        }
+        else if (tag == "includedPedProps" && firstOf(seen, IncludedProps)) {
+            ok = reader.isEmptyElement() ||
+                 parseIncludedItems(reader, outfit.props, "eAnchorPoint", &XmlItem::eAnchorPoint);
+        }
+        else {
+            ok = reader.skipElement();
+        }
+
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// includedPedComponents / includedPedProps: nameHash plus the component or anchor type
+bool ShopMetaExtractor::parseIncludedItems(XmlPullReader& reader, std::vector<XmlItem>& items,
+                                           std::string_view typeTag, std::string_view XmlItem::*typeField) {
+    Event event;
+    while ((event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+        if (event != Event::StartElement) {
+            continue;
+        }
+        if (reader.name() != "Item") {
+            if (!reader.skipElement()) {
+                return false;
+            }
+            continue;
+        }
+
+        XmlItem item;
+        if (!reader.isEmptyElement()) {
+            unsigned seen = 0;
+            while ((event = reader.next()) != Event::EndElement) {
+                if (event == Event::Error || event == Event::EndOfDocument) {
+                    return false;
+                }
+                if (event != Event::StartElement) {
+                    continue;
+                }
+
+                bool ok = true;
+                if (reader.name() == "nameHash" && firstOf(seen, UniqueNameHash)) {
+                    ok = readText(reader, item.uniqueNameHash);
+                }
+                else if (reader.name() == typeTag && firstOf(seen, TypeTag)) {
+                    ok = readInterned(reader, item.*typeField);
+                }
+                else {
+                    ok = reader.skipElement();
+                }
+
+                if (!ok) {
+                    return false;
+                }
+            }
+        }
+        items.push_back(std::move(item));
+    }
+    return true;
+}
+
+bool ShopMetaExtractor::parseItems(XmlPullReader& reader, XmlNode& node, bool props) {
+    logger->log(props ? "Parsing pedProps..." : "Parsing pedComponents...");
+    std::string_view currentName = Core::Defaults::NA;
+
+    Event event;
+    while ((event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+
+        if (event == Event::Comment) {
+            currentName = XmlPullReader::decode(reader.value(), strings, false);
+            logger->log((props ? "Found prop comment: " : "Found component comment: ") + std::string(currentName));
+        }
+        else if (event == Event::StartElement) {
+            if (reader.name() != "Item") {
+                if (!reader.skipElement()) {
+                    return false;
+                }
+                continue;
+            }
+
+            XmlItem itemData;
+            itemData.itemName = currentName;
+            if (!parseItem(reader, itemData, props, node.columns)) {
+                return false;
+            }
+
+            if (props) {
+                logger->log("Found prop - Name: " + std::string(itemData.itemName) +
+                            ", Hash: " + std::string(itemData.uniqueNameHash) +
+                            ", Anchor: " + std::string(itemData.eAnchorPoint));
+            }
+            else {
+                logger->log("Found item - Name: " + std::string(itemData.itemName) +
+                            ", Hash: " + std::string(itemData.uniqueNameHash) +
+                            ", Type: " + std::string(itemData.eCompType));
+            }
+
+            node.items.push_back(std::move(itemData));
+            currentName = Core::Defaults::NA;
+        }
+    }
+    return true;
+}
+
+// Fills `item` and appends its row to `columns`; the element may be empty
+bool ShopMetaExtractor::parseItem(XmlPullReader& reader, XmlItem& item, bool props, ShopItemColumns& columns) {
+    std::string_view indexTag = props ? "propIndex" : "localDrawableIndex";
+    std::string_view typeTag = props ? "eAnchorPoint" : "eCompType";
+
+    // Number text is converted once the item is complete, so errors can name its hash
+    std::string_view indexText;
+    std::string_view textureText;
+    std::string_view costText;
+    std::string_view drawableText;
+    std::string_view shopEnum;
+
+    bool empty = reader.isEmptyElement();
+    unsigned seen = 0;
+    Event event;
+    while (!empty && (event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+        if (event != Event::StartElement) {
+            continue;
+        }
+
+        std::string_view tag = reader.name();
+        bool ok = true;
+        if (tag == "lockHash" && firstOf(seen, LockHash)) {
+            ok = readInterned(reader, item.lockHash);
+        }
+        else if (tag == "textLabel" && firstOf(seen, TextLabel)) {
+            ok = readText(reader, item.textLabel);
+        }
+        else if (tag == "uniqueNameHash" && firstOf(seen, UniqueNameHash)) {
+            ok = readText(reader, item.uniqueNameHash);
+        }
+        else if (tag == indexTag && firstOf(seen, Index)) {
+            indexText = XmlPullReader::decode(reader.attribute("value"), strings);
+            ok = reader.skipElement();
+        }
+        else if (tag == "textureIndex" && firstOf(seen, TextureIndex)) {
+            // The index is stored in a value attribute; like parseNode this reads the (empty) text
+            ok = readText(reader, textureText);
+        }
+        else if (tag == typeTag && firstOf(seen, TypeTag)) {
+            ok = readInterned(reader, props ? item.eAnchorPoint : item.eCompType);
+        }
+        else if (tag == Core::XmlNodes::COST && firstOf(seen, Cost)) {
+            costText = XmlPullReader::decode(reader.attribute("value"), strings);
+            ok = reader.skipElement();
+        }
+        else if (tag == Core::XmlNodes::DRAWABLE_INDEX && firstOf(seen, DrawableIndex)) {
+            drawableText = XmlPullReader::decode(reader.attribute("value"), strings);
+            ok = reader.skipElement();
+        }
+        else if (tag == Core::XmlNodes::SHOP_ENUM && firstOf(seen, ShopEnum)) {
+            ok = readInterned(reader, shopEnum);
+        }
+        else if (tag == Core::XmlNodes::RESTRICTION_TAGS && firstOf(seen, RestrictionTags)) {
+            ok = parseNameList(reader, Core::XmlNodes::TAG_NAME_HASH, columns.restrictionTags);
+        }
+        else if (tag == Core::XmlNodes::FORCED_COMPONENTS && firstOf(seen, ForcedComponents)) {
+            ok = parseNameList(reader, Core::XmlNodes::NAME_HASH, columns.forcedComponents);
+        }
+        else if (tag == Core::XmlNodes::VARIANT_COMPONENTS && firstOf(seen, VariantComponents)) {
+            ok = parseNameList(reader, Core::XmlNodes::NAME_HASH, columns.variantComponents);
+        }
+        else {
+            ok = reader.skipElement();
+        }
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    (props ? item.propIndex : item.localDrawableIndex) =
+        ShopMetaFields::parseItemIndex(indexText, indexTag, item.uniqueNameHash, numericErrors, *logger);
+    item.textureIndex = ShopMetaFields::parseItemIndex(textureText, "textureIndex", item.uniqueNameHash, numericErrors, *logger);
+
+    columns.cost.push_back(ShopMetaFields::parseItemIndex(costText, Core::XmlNodes::COST, item.uniqueNameHash, numericErrors, *logger));
+    columns.drawableIndex.push_back(
+        ShopMetaFields::parseItemIndex(drawableText, Core::XmlNodes::DRAWABLE_INDEX, item.uniqueNameHash, numericErrors, *logger));
+    columns.shopEnum.push_back(Core::intern(shopEnum));
+    columns.restrictionTags.endRow();
+    columns.forcedComponents.endRow();
+    columns.variantComponents.endRow();
+    return true;
+}
+
+// restrictionTags / forcedComponents / variantComponents: the `valueTag` text of each
+// <Item>, added to the row being built (the caller ends the row)
+bool ShopMetaExtractor::parseNameList(XmlPullReader& reader, std::string_view valueTag, ShopItemListColumn& column) {
+    if (reader.isEmptyElement()) {
+        return true;
+    }
+
+    Event event;
+    while ((event = reader.next()) != Event::EndElement) {
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+        if (event != Event::StartElement) {
+            continue;
+        }
+        if (reader.name() != "Item") {
+            if (!reader.skipElement()) {
+                return false;
+            }
+            continue;
+        }
+
+        std::string_view value;
+        if (!reader.isEmptyElement()) {
+            bool found = false;
+            while ((event = reader.next()) != Event::EndElement) {
+                if (event == Event::Error || event == Event::EndOfDocument) {
+                    return false;
+                }
+                if (event != Event::StartElement) {
+                    continue;
+                }
+
+                bool first = !found && reader.name() == valueTag;
+                found = found || first;
+                if (!(first ? readText(reader, value) : reader.skipElement())) {
+                    return false;
+                }
+            }
+        }
+        column.values.push_back(Core::intern(value));
+    }
+    return true;
+}
+
+bool ShopMetaExtractor::fail(XmlPullReader& reader) {
+    if (!reader.errorMessage().empty()) {
+        error = reader.errorMessage();
+        errorAt = reader.errorOffset();
+    }
+    else {
+        error = "unexpected end of document";
+        errorAt = reader.offset();
+    }
+    return false;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "../Core/Interfaces.h"
+#include "../Core/StringStore.h"
+#include "XmlParser.h"
+#include "XmlPullReader.h"
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Single-pass extractor for the ShopPedApparel schema.
+// Reads each <Item> once, dispatches on tag name and skips every subtree the
+// tool does not use (variantProps, locate, ...) without building nodes.
+// Produces the same XmlNode (side table included) as XmlParser::parseNode:
+// values are views into the input buffer, except the rare ones that need
+// unescaping or line-ending normalisation, which are copied into `strings`.
+class ShopMetaExtractor {
+public:
+    ShopMetaExtractor(std::shared_ptr<Core::ILogger> logger, Core::StringStore& strings, size_t& numericErrors);
+
+    bool extract(std::string_view buffer, XmlNode& node);
+
+    std::string_view errorMessage() const { return error; }
+    size_t errorOffset() const { return errorAt; }
+
+private:
+    std::shared_ptr<Core::ILogger> logger;
+    Core::StringStore& strings;
+    size_t& numericErrors;
+    std::string_view error;
+    size_t errorAt{0};
+
+    bool readText(XmlPullReader& reader, std::string_view& out);
+    bool readInterned(XmlPullReader& reader, std::string_view& out);
+    bool parseOutfits(XmlPullReader& reader, XmlNode& node);
+    bool parseOutfit(XmlPullReader& reader, XmlOutfit& outfit);
+    bool parseIncludedItems(XmlPullReader& reader, std::vector<XmlItem>& items, std::string_view typeTag,
+                            std::string_view XmlItem::*typeField);
+    bool parseItems(XmlPullReader& reader, XmlNode& node, bool props);
+    bool parseItem(XmlPullReader& reader, XmlItem& item, bool props, ShopItemColumns& columns);
+    bool parseNameList(XmlPullReader& reader, std::string_view valueTag, ShopItemListColumn& column);
+    bool fail(XmlPullReader& reader);
+};
@@ -0,0 +1,15 @@
+#include "ShopMetaFields.h"
+#include "../Core/Constants.h"
+#include <string>
+
+namespace ShopMetaFields {
+    int32_t parseItemIndex(std::string_view text, std::string_view field, std::string_view hash,
+                           size_t& numericErrors, Core::ILogger& logger) {
+        int32_t index;
+        if (!Core::ComponentUtils::parseId(text, index)) {
+            ++numericErrors;
+            logger.error("Failed to parse " + std::string(field) + " '" + std::string(text) + "' for " + std::string(hash));
+        }
+        return index;
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "../Core/Interfaces.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Field parsing shared by the DOM (XmlParser) and pull (ShopMetaExtractor) shop meta readers
+namespace ShopMetaFields {
+    // Core::ComponentUtils::parseId for one index field of a shop meta item, logging and
+    // counting a value that is not an integer
+    int32_t parseItemIndex(std::string_view text, std::string_view field, std::string_view hash,
+                           size_t& numericErrors, Core::ILogger& logger);
+}
@@ -0,0 +1,28 @@
+#include "XmlDocumentLoader.h"
+#include "../Core/Compression.h"
+
+pugi::xml_parse_result loadXmlDocument(pugi::xml_document& doc, Core::InputFile& input, const Core::TarBundle* bundle,
+                                       const std::string& path, XmlIngestMode mode, unsigned int flags,
+                                       std::string& error) {
+    bool plainFile = !(bundle && bundle->find(path)) && !Core::Compression::hasCompressedSuffix(path);
+    if (mode == XmlIngestMode::File && plainFile) {
+        return doc.load_file(path.c_str(), flags);
+    }
+
+    auto access = mode == XmlIngestMode::File ? Core::InputFile::Access::ReadOnly : Core::InputFile::Access::CopyOnWrite;
+    if (!input.open(bundle, path, access, error)) {
+        pugi::xml_parse_result result;
+        result.status = pugi::status_io_error;
+        return result;
+    }
+
+    if (mode == XmlIngestMode::File) {
+        pugi::xml_parse_result result = doc.load_buffer(input.data(), input.size(), flags);
+        input.close();
+        return result;
+    }
+
+    // The parser terminates and unescapes strings inside the buffer; with a private
+    // mapping those writes only dirty the pages they touch and never reach the file
+    return doc.load_buffer_inplace(input.data(), input.size(), flags);
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "../Core/InputFile.h"
+#include "../Core/TarBundle.h"
+#include "pugixml/pugixml.hpp"
+#include <string>
+
+// How .meta files are brought into memory before pugixml parses them
+enum class XmlIngestMode {
+    File,         // pugi::xml_document::load_file, text copied into a heap buffer owned by the document
+    MemoryMapped, // Copy-on-write mapping parsed in place, node names and values point into the mapping
+    Pull          // Read-only mapping scanned once by a schema-specific extractor, no DOM built
+};
+
+// Load `path` into `doc` using the requested ingest mode (Pull is parsed in place
+// like MemoryMapped, for callers that have no extractor and need a DOM). The text comes
+// from `bundle` when it has the member and is inflated first when gzip-compressed; File
+// mode copies it into the document either way. Otherwise the document does not own its
+// text: `input` must outlive `doc` and every string_view taken from it. When the file
+// cannot be read, `error` says why and the result is status_io_error.
+pugi::xml_parse_result loadXmlDocument(pugi::xml_document& doc, Core::InputFile& input, const Core::TarBundle* bundle,
+                                       const std::string& path, XmlIngestMode mode, unsigned int flags,
+                                       std::string& error);
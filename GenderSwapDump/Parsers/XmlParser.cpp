@@ -1,9 +1,157 @@
 #include "XmlParser.h"
 #include <filesystem>
+#include <algorithm>
+#include "../Core/Compression.h"
 #include "../Core/Constants.h"
+#include "../Core/Hash.h"
+#include "../Core/ParallelFor.h"
+#include "../Core/StringPool.h"
+#include "ShopMetaExtractor.h"
+#include "ShopMetaFields.h"
+#include "CorpusSnapshot.h"
+#include <chrono>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
 #include "iostream"
-XmlParser::XmlParser(std::shared_ptr<Core::ILogger> logger)
+
+namespace {
+    // Whitespace-only PCDATA stays dropped (no parse_ws_pcdata) and CDATA / attribute
+    // whitespace conversion are skipped: shop meta files use neither. Comments carry
+    // the item names; parse_eol keeps multi-line comments identical across CRLF/LF files.
+    constexpr unsigned int SHOP_META_PARSE_FLAGS =
+        pugi::parse_comments | pugi::parse_escapes | pugi::parse_eol;
+
+    // Shop meta elements parseNode reads, in the order of TAG_NAMES
+    enum class Tag : size_t {
+        PedName, DlcName, FullDlcName, PedOutfits, PedComponents, PedProps, Item,
+        LockHash, TextLabel, UniqueNameHash, LocalDrawableIndex, PropIndex, TextureIndex,
+        CompType, AnchorPoint, IncludedComponents, IncludedProps, NameHash,
+        Cost, DrawableIndex, ShopEnum, RestrictionTags, ForcedComponents, VariantComponents, TagNameHash,
+        Count,
+        Other = Count
+    };
+
+    constexpr std::string_view TAG_NAMES[] = {
+        Core::XmlNodes::PED_NAME, Core::XmlNodes::DLC_NAME, Core::XmlNodes::FULL_DLC_NAME,
+        Core::XmlNodes::PED_OUTFITS, Core::XmlNodes::PED_COMPONENTS, Core::XmlNodes::PED_PROPS,
+        Core::XmlNodes::ITEM, Core::XmlNodes::LOCK_HASH, Core::XmlNodes::TEXT_LABEL,
+        Core::XmlNodes::UNIQUE_HASH, Core::XmlNodes::LOCAL_DRAWABLE_INDEX, Core::XmlNodes::PROP_INDEX,
+        Core::XmlNodes::TEXTURE_INDEX, Core::XmlNodes::COMP_TYPE, Core::XmlNodes::ANCHOR_POINT,
+        Core::XmlNodes::INCLUDED_COMPONENTS, Core::XmlNodes::INCLUDED_PROPS, Core::XmlNodes::NAME_HASH,
+        Core::XmlNodes::COST, Core::XmlNodes::DRAWABLE_INDEX, Core::XmlNodes::SHOP_ENUM,
+        Core::XmlNodes::RESTRICTION_TAGS, Core::XmlNodes::FORCED_COMPONENTS, Core::XmlNodes::VARIANT_COMPONENTS,
+        Core::XmlNodes::TAG_NAME_HASH
+    };
+    static_assert(std::size(TAG_NAMES) == static_cast<size_t>(Tag::Count), "TAG_NAMES must list every Tag");
+
+    constexpr uint64_t tagHash(Tag tag) {
+        return Core::Hash::fnv1a64(TAG_NAMES[static_cast<size_t>(tag)]);
+    }
+
+    // Maps an element name to its Tag by switching on the name's FNV-1a hash. Two tags
+    // with the same hash would be duplicate case labels and fail to compile, so the
+    // switch is a perfect hash over TAG_NAMES; one name comparison rejects other tags
+    // that happen to land on a case.
+    Tag classifyTag(std::string_view name) {
+        Tag tag;
+        switch (Core::Hash::fnv1a64(name)) {
+            case tagHash(Tag::PedName): tag = Tag::PedName; break;
+            case tagHash(Tag::DlcName): tag = Tag::DlcName; break;
+            case tagHash(Tag::FullDlcName): tag = Tag::FullDlcName; break;
+            case tagHash(Tag::PedOutfits): tag = Tag::PedOutfits; break;
+            case tagHash(Tag::PedComponents): tag = Tag::PedComponents; break;
+            case tagHash(Tag::PedProps): tag = Tag::PedProps; break;
+            case tagHash(Tag::Item): tag = Tag::Item; break;
+            case tagHash(Tag::LockHash): tag = Tag::LockHash; break;
+            case tagHash(Tag::TextLabel): tag = Tag::TextLabel; break;
+            case tagHash(Tag::UniqueNameHash): tag = Tag::UniqueNameHash; break;
+            case tagHash(Tag::LocalDrawableIndex): tag = Tag::LocalDrawableIndex; break;
+            case tagHash(Tag::PropIndex): tag = Tag::PropIndex; break;
+            case tagHash(Tag::TextureIndex): tag = Tag::TextureIndex; break;
+            case tagHash(Tag::CompType): tag = Tag::CompType; break;
+            case tagHash(Tag::AnchorPoint): tag = Tag::AnchorPoint; break;
+            case tagHash(Tag::IncludedComponents): tag = Tag::IncludedComponents; break;
+            case tagHash(Tag::IncludedProps): tag = Tag::IncludedProps; break;
+            case tagHash(Tag::NameHash): tag = Tag::NameHash; break;
+            case tagHash(Tag::Cost): tag = Tag::Cost; break;
+            case tagHash(Tag::DrawableIndex): tag = Tag::DrawableIndex; break;
+            case tagHash(Tag::ShopEnum): tag = Tag::ShopEnum; break;
+            case tagHash(Tag::RestrictionTags): tag = Tag::RestrictionTags; break;
+            case tagHash(Tag::ForcedComponents): tag = Tag::ForcedComponents; break;
+            case tagHash(Tag::VariantComponents): tag = Tag::VariantComponents; break;
+            case tagHash(Tag::TagNameHash): tag = Tag::TagNameHash; break;
+            default: return Tag::Other;
+        }
+        return name == TAG_NAMES[static_cast<size_t>(tag)] ? tag : Tag::Other;
+    }
+
+    // The first child element with each Tag, found in a single walk over the siblings.
+    // Like pugixml's child(), a missing element is a null node and a repeated one keeps
+    // its first occurrence.
+    class TagChildren {
+    public:
+        explicit TagChildren(const pugi::xml_node& parent) {
+            for (auto child = parent.first_child(); child; child = child.next_sibling()) {
+                if (child.type() != pugi::node_element) {
+                    continue;
+                }
+                Tag tag = classifyTag(child.name());
+                if (tag != Tag::Other && !slots[static_cast<size_t>(tag)]) {
+                    slots[static_cast<size_t>(tag)] = child;
+                }
+            }
+        }
+
+        pugi::xml_node operator[](Tag tag) const { return slots[static_cast<size_t>(tag)]; }
+
+    private:
+        pugi::xml_node slots[static_cast<size_t>(Tag::Count)];
+    };
+
+    // One row of a list column: the `value` child of each <Item> in `list`
+    void appendListRow(const pugi::xml_node& list, Tag value, ShopItemListColumn& column) {
+        for (auto entry : list.children("Item")) {
+            column.values.push_back(Core::intern(TagChildren(entry)[value].child_value()));
+        }
+        column.endRow();
+    }
+
+    void appendColumns(const TagChildren& fields, std::string_view hash, ShopItemColumns& columns,
+                       size_t& numericErrors, Core::ILogger& logger) {
+        columns.cost.push_back(ShopMetaFields::parseItemIndex(fields[Tag::Cost].attribute("value").as_string(),
+                                                              Core::XmlNodes::COST, hash, numericErrors, logger));
+        columns.drawableIndex.push_back(ShopMetaFields::parseItemIndex(fields[Tag::DrawableIndex].attribute("value").as_string(),
+                                                                       Core::XmlNodes::DRAWABLE_INDEX, hash, numericErrors, logger));
+        columns.shopEnum.push_back(Core::intern(fields[Tag::ShopEnum].child_value()));
+        appendListRow(fields[Tag::RestrictionTags], Tag::TagNameHash, columns.restrictionTags);
+        appendListRow(fields[Tag::ForcedComponents], Tag::NameHash, columns.forcedComponents);
+        appendListRow(fields[Tag::VariantComponents], Tag::NameHash, columns.variantComponents);
+    }
+
+    // Raw text of every <name>...</name> element, found without parsing; never empty so
+    // front() is safe (an empty view stands for "none")
+    std::vector<std::string_view> elementText(std::string_view content, std::string_view name) {
+        std::string open = "<" + std::string(name) + ">";
+        std::vector<std::string_view> values;
+        for (size_t begin = content.find(open); begin != std::string_view::npos; begin = content.find(open, begin)) {
+            begin += open.size();
+            size_t end = content.find('<', begin);
+            if (end == std::string_view::npos) {
+                break;
+            }
+            values.push_back(content.substr(begin, end - begin));
+        }
+        if (values.empty()) {
+            values.emplace_back();
+        }
+        return values;
+    }
+}
+
+XmlParser::XmlParser(std::shared_ptr<Core::ILogger> logger, XmlParserOptions options)
     : logger(std::move(logger))
+    , options(options)
 {
 }
 
@@ -16,17 +164,58 @@ bool XmlParser::parse() {
 
         std::cout << "scanDirectory done" << std::endl;
 
-        for (const auto& path : filePaths) {
-            std::cout << path << std::endl;
+        // Sorted paths make the node order independent of directory iteration order
+        std::sort(files.begin(), files.end(),
+                  [](const Core::ScannedFile& a, const Core::ScannedFile& b) { return a.path < b.path; });
 
-            if (!loadXmlFile(path)) {
-                logger->error("Failed to load XML file: " + path);
+        if (options.dlcs && !selectDlcFiles()) {
+            return false;
+        }
+
+        // Overlay layers follow the base, each sorted on its own so later layers win
+        baseFileCount = files.size();
+        for (const auto& overlay : options.overlays) {
+            size_t layerStart = files.size();
+            if (!scanDirectory((std::filesystem::path(overlay) / Core::FileConstants::XML_DIR).generic_string(), true)) {
+                logger->error("Failed to scan XML overlay " + overlay);
                 return false;
             }
+            std::sort(files.begin() + layerStart, files.end(),
+                      [](const Core::ScannedFile& a, const Core::ScannedFile& b) { return a.path < b.path; });
+        }
+
+        // File names already tell the genders apart, so each node list is sized once
+        size_t males = Core::countGender(files, Core::InputGender::Male);
+        size_t females = Core::countGender(files, Core::InputGender::Female);
+        size_t namedDlcs = static_cast<size_t>(std::count_if(files.begin(), files.end(),
+            [](const Core::ScannedFile& file) { return file.kind.dlc != nullptr; }));
+        logger->log("Scanned " + std::to_string(files.size()) + " shop meta files: " + std::to_string(males) +
+                    " male, " + std::to_string(females) + " female, " + std::to_string(namedDlcs) +
+                    " named after a known DLC");
+        maleNodes.reserve(males);
+        femaleNodes.reserve(females);
+
+        unsigned threads = Core::resolveThreadCount(options.threadCount, files.size());
+        bool loaded = threads > 1 ? loadFilesParallel(threads) : loadFilesSerial();
+        if (!loaded) {
+            return false;
         }
 
         std::cout << " XmlParser::loadXmlFile" << std::endl;
 
+        if (snapshot) {
+            logger->log("Shop meta files: " + std::to_string(reusedFiles) + " reused from snapshot, " +
+                        std::to_string(files.size() - reusedFiles) + " re-parsed");
+        }
+        std::unordered_map<std::string_view, HashTarget>().swap(hashIndex);  // Keys may point into documents compact() frees
+        if (!options.overlays.empty()) {
+            logger->log("Shop meta overlays: " + std::to_string(files.size() - baseFileCount) + " files, " +
+                        std::to_string(overriddenItems) + " items and outfits overridden by uniqueNameHash");
+        }
+        if (numericErrors > 0) {
+            logger->error(std::to_string(numericErrors) + " shop meta index fields could not be parsed");
+        }
+
         valid = true;
         return true;
     }
@@ -36,52 +225,238 @@ bool XmlParser::parse() {
     }
 }
 
-bool XmlParser::loadXmlFile(const std::string& path) {
-    pugi::xml_document doc;
-    pugi::xml_parse_result result = doc.load_file(path.c_str(), pugi::parse_default | pugi::parse_comments);
+bool XmlParser::loadFilesSerial() {
+    for (size_t i = 0; i < files.size(); ++i) {
+        const std::string& path = files[i].path;
+        std::cout << path << std::endl;
+
+        LoadedFile file;
+        if (!acquireFile(path, file)) {
+            logger->error("Failed to load XML file: " + path);
+            return false;
+        }
+
+        keepFile(files[i], file, i >= baseFileCount);
+    }
+    return true;
+}
+
+bool XmlParser::loadFilesParallel(unsigned threads) {
+    // Largest files first so the 80k-line gunrunning meta doesn't start last
+    std::vector<size_t> order = Core::largestFirst(files);
+
+    logger->log("Loading " + std::to_string(files.size()) + " XML files on " +
+                std::to_string(threads) + " threads");
+
+    std::vector<LoadedFile> loadedFiles(files.size());
+    std::vector<char> loaded(files.size(), 0);
+    Core::parallelFor(order, threads, [&](size_t i) {
+        loaded[i] = acquireFile(files[i].path, loadedFiles[i]);
+    });
+
+    // Merge in path order so the result never depends on which worker finished first
+    for (size_t i = 0; i < loadedFiles.size(); ++i) {
+        if (!loaded[i]) {
+            logger->error("Failed to load XML file: " + files[i].path);
+            return false;
+        }
+
+        keepFile(files[i], loadedFiles[i], i >= baseFileCount);
+    }
+    return true;
+}
+
+// Take ownership of everything the file's views point into, then file its node
+void XmlParser::keepFile(const Core::ScannedFile& input, LoadedFile& file, bool overlay) {
+    if (overlay) {
+        applyOverlay(file.node);
+    }
+
+    FileResult result{ input.path, file.stamp, file.numericErrors };
+    size_t males = maleNodes.size();
+    size_t females = femaleNodes.size();
+    categorizeNode(file.node);
+    if (maleNodes.size() > males) {
+        result.nodes = &maleNodes;
+        result.nodeIndex = males;
+    }
+    else if (femaleNodes.size() > females) {
+        result.nodes = &femaleNodes;
+        result.nodeIndex = females;
+    }
+    // The pedName decides; a file name saying otherwise is most likely a misplaced file
+    Core::InputGender filed = result.nodes == &maleNodes ? Core::InputGender::Male
+                            : result.nodes == &femaleNodes ? Core::InputGender::Female : Core::InputGender::Unknown;
+    if (input.kind.gender != Core::InputGender::Unknown && filed != Core::InputGender::Unknown && filed != input.kind.gender) {
+        logger->log("Warning: pedName of " + input.path + " disagrees with the gender in its file name");
+    }
+    if (!options.overlays.empty() && result.nodes) {
+        indexNode(result.nodes == &maleNodes ? &maleNodes : &femaleNodes, result.nodeIndex);
+    }
+    fileResults.push_back(std::move(result));
+    reusedFiles += file.reused ? 1 : 0;
+
+    numericErrors += file.numericErrors;
+    if (file.reused) {
+        return;
+    }
+    if (options.ingestMode != XmlIngestMode::Pull) {
+        documents.push_back(std::move(file.doc));
+    }
+    if (file.input.isOpen()) {
+        inputs.push_back(std::move(file.input));
+    }
+    if (file.strings.size() > 0) {
+        stringStores.push_back(std::move(file.strings));
+    }
+}
+
+// Moves the overlay node's items and outfits whose uniqueNameHash is already filed into
+// those slots, replacing the earlier layer's entries; the rest stay in the node
+void XmlParser::applyOverlay(XmlNode& node) {
+    std::vector<XmlItem> newItems;
+    ShopItemColumns newColumns;
+    for (size_t i = 0; i < node.items.size(); ++i) {
+        auto it = node.items[i].uniqueNameHash.empty() ? hashIndex.end() : hashIndex.find(node.items[i].uniqueNameHash);
+        if (it != hashIndex.end() && !it->second.outfit) {
+            XmlNode& target = (*it->second.nodes)[it->second.node];
+            target.items[it->second.index] = std::move(node.items[i]);
+            target.columns.assignRow(it->second.index, node.columns, i);
+            ++overriddenItems;
+        }
+        else {
+            newItems.push_back(std::move(node.items[i]));
+            newColumns.appendRow(node.columns, i);
+        }
+    }
+
+    std::vector<XmlOutfit> newOutfits;
+    for (XmlOutfit& outfit : node.outfits) {
+        auto it = outfit.uniqueNameHash.empty() ? hashIndex.end() : hashIndex.find(outfit.uniqueNameHash);
+        if (it != hashIndex.end() && it->second.outfit) {
+            (*it->second.nodes)[it->second.node].outfits[it->second.index] = std::move(outfit);
+            ++overriddenItems;
+        }
+        else {
+            newOutfits.push_back(std::move(outfit));
+        }
+    }
+
+    node.items.swap(newItems);
+    node.columns = std::move(newColumns);
+    node.outfits.swap(newOutfits);
+}
+
+// First occurrence wins, so an overlay replaces the entry enrichment would have used
+void XmlParser::indexNode(std::vector<XmlNode>* nodes, size_t nodeIndex) {
+    const XmlNode& node = (*nodes)[nodeIndex];
+    for (size_t i = 0; i < node.items.size(); ++i) {
+        if (!node.items[i].uniqueNameHash.empty()) {
+            hashIndex.try_emplace(node.items[i].uniqueNameHash,
+                                  HashTarget{ nodes, static_cast<uint32_t>(nodeIndex), static_cast<uint32_t>(i), false });
+        }
+    }
+    for (size_t i = 0; i < node.outfits.size(); ++i) {
+        if (!node.outfits[i].uniqueNameHash.empty()) {
+            hashIndex.try_emplace(node.outfits[i].uniqueNameHash,
+                                  HashTarget{ nodes, static_cast<uint32_t>(nodeIndex), static_cast<uint32_t>(i), true });
+        }
+    }
+}
+
+// Takes the file's node from the snapshot if it is unchanged, otherwise loads it;
+// only reads parser state, so it can run on any thread
+bool XmlParser::acquireFile(const std::string& path, LoadedFile& file) {
+    if (snapshot) {
+        if (auto* cached = snapshot->findXmlFile(path, file.stamp)) {
+            file.node = std::move(cached->node);
+            file.numericErrors = cached->numericErrors;
+            file.reused = true;
+            return true;
+        }
+    }
+
+    if (!Core::readInputStamp(options.bundle.get(), path, file.stamp)) {
+        return false;
+    }
+    return loadXmlFile(path, file);
+}
+
+// Loads and extracts one file; touches no parser state so it can run on any thread
+bool XmlParser::loadXmlFile(const std::string& path, LoadedFile& file) {
+    if (options.ingestMode == XmlIngestMode::Pull) {
+        return extractXmlFile(path, file);
+    }
+
+    std::string error;
+    pugi::xml_parse_result result =
+        loadXmlDocument(file.doc, file.input, options.bundle.get(), path, options.ingestMode, SHOP_META_PARSE_FLAGS, error);
 
     std::cout << " XmlParser::loadXmlFile" << std::endl;
 
     if (!result) {
-        logger->error("XML parse error: " + std::string(result.description()));
+        logger->error("XML parse error: " + (error.empty() ? std::string(result.description()) : error));
         return false;
     }
 
     std::cout << " XmlParser::loadXmlFile" << std::endl;
 
-    XmlNode node;
-    if (!parseNode(doc.document_element(), node)) {
+    return parseNode(file.doc.document_element(), file.node, file.numericErrors);
+}
+
+// Pull mode: one pass over a read-only mapping (or the inflated text), no DOM
+bool XmlParser::extractXmlFile(const std::string& path, LoadedFile& file) {
+    std::string error;
+    if (!file.input.open(options.bundle.get(), path, Core::InputFile::Access::ReadOnly, error)) {
+        logger->error("Failed to map XML file: " + error);
+        return false;
+    }
+    std::string_view content = file.input.view();
+
+    auto start = std::chrono::steady_clock::now();
+    ShopMetaExtractor extractor(logger, file.strings, file.numericErrors);
+    bool ok = extractor.extract(content, file.node);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (!ok) {
+        logger->error("XML parse error in " + path + " at offset " + std::to_string(extractor.errorOffset()) +
+                      ": " + std::string(extractor.errorMessage()));
         return false;
     }
 
-    categorizeNode(node);
-    documents.push_back(std::move(doc));
+    double megabytes = content.size() / (1024.0 * 1024.0);
+    double seconds = elapsed.count();
+    logger->log("Extracted " + path + ": " + std::to_string(content.size()) + " bytes in " +
+                std::to_string(seconds * 1000.0) + " ms (" +
+                std::to_string(seconds > 0 ? megabytes / seconds : 0.0) + " MB/s)");
     return true;
 }
 
-bool XmlParser::parseNode(const pugi::xml_node& xmlNode, XmlNode& outNode) {
+bool XmlParser::parseNode(const pugi::xml_node& xmlNode, XmlNode& outNode, size_t& numericErrors) {
     try {
         logger->log("Parsing XML node...");
 
+        TagChildren top(xmlNode);
+
         // Parse basic node info
-        if (auto pedName = xmlNode.child("pedName")) {
-            outNode.pedName = pedName.child_value();
+        if (auto pedName = top[Tag::PedName]) {
+            outNode.pedName = Core::intern(pedName.child_value());
             logger->log("Found pedName: " + std::string(outNode.pedName));
         }
 
-        if (auto dlcName = xmlNode.child("dlcName")) {
-            outNode.dlcName = dlcName.child_value();
+        if (auto dlcName = top[Tag::DlcName]) {
+            outNode.dlcName = Core::intern(dlcName.child_value());
             logger->log("Found dlcName: " + std::string(outNode.dlcName));
         }
 
-        if (auto fullDlcName = xmlNode.child("fullDlcName")) {
-            outNode.fullDlcName = fullDlcName.child_value();
+        if (auto fullDlcName = top[Tag::FullDlcName]) {
+            outNode.fullDlcName = Core::intern(fullDlcName.child_value());
             logger->log("Found fullDlcName: " + std::string(outNode.fullDlcName));
         }
 
         // Parse outfits
         logger->log("Parsing pedOutfits...");
-        auto outfitsNode = xmlNode.child("pedOutfits");
+        auto outfitsNode = top[Tag::PedOutfits];
         if (outfitsNode) {
             std::string_view currentOutfitName = Core::Defaults::NA;
 
@@ -95,28 +470,31 @@ bool XmlParser::parseNode(const pugi::xml_node& xmlNode, XmlNode& outNode) {
                     logger->log("Found outfit comment: " + std::string(currentOutfitName));
                 }
                 // Process outfit Item node
-                else if (std::string(node.name()) == "Item") {
+                else if (classifyTag(node.name()) == Tag::Item) {
+                    TagChildren fields(node);
                     XmlOutfit outfit;
                     outfit.outfitName = currentOutfitName;
-                    outfit.lockHash = node.child("lockHash").child_value();
-                    outfit.textLabel = node.child("textLabel").child_value();
-                    outfit.uniqueNameHash = node.child("uniqueNameHash").child_value();
+                    outfit.lockHash = Core::intern(fields[Tag::LockHash].child_value());
+                    outfit.textLabel = fields[Tag::TextLabel].child_value();
+                    outfit.uniqueNameHash = fields[Tag::UniqueNameHash].child_value();
 
                     // Parse included components
-                    for (auto comp : node.child("includedPedComponents").children("Item")) {
+                    for (auto comp : fields[Tag::IncludedComponents].children("Item")) {
+                        TagChildren compFields(comp);
                         XmlItem item;
-                        item.uniqueNameHash = comp.child("nameHash").child_value();
+                        item.uniqueNameHash = compFields[Tag::NameHash].child_value();
                         //item.enumValue = comp.child("enumValue").attribute("value").as_string();
-                        item.eCompType = comp.child("eCompType").child_value();
+                        item.eCompType = Core::intern(compFields[Tag::CompType].child_value());
                         outfit.components.push_back(std::move(item));
                     }
 
                     // Parse included props
-                    for (auto prop : node.child("includedPedProps").children("Item")) {
+                    for (auto prop : fields[Tag::IncludedProps].children("Item")) {
+                        TagChildren propFields(prop);
                         XmlItem item;
-                        item.uniqueNameHash = prop.child("nameHash").child_value();
+                        item.uniqueNameHash = propFields[Tag::NameHash].child_value();
                         //item.enumValue = prop.child("enumValue").attribute("value").as_string();
-                        item.eAnchorPoint = prop.child("eAnchorPoint").child_value();
+                        item.eAnchorPoint = Core::intern(propFields[Tag::AnchorPoint].child_value());
                         outfit.props.push_back(std::move(item));
                     }
 
@@ -133,7 +511,7 @@ bool XmlParser::parseNode(const pugi::xml_node& xmlNode, XmlNode& outNode) {
 
         // Parse pedComponents
         logger->log("Parsing pedComponents...");
-        auto componentsNode = xmlNode.child("pedComponents");
+        auto componentsNode = top[Tag::PedComponents];
         if (componentsNode) {
             std::string_view currentComponentName = Core::Defaults::NA;
 
@@ -142,15 +520,19 @@ bool XmlParser::parseNode(const pugi::xml_node& xmlNode, XmlNode& outNode) {
                     currentComponentName = node.value();
                     logger->log("Found component comment: " + std::string(currentComponentName));
                 }
-                else if (std::string(node.name()) == "Item") {
+                else if (classifyTag(node.name()) == Tag::Item) {
+                    TagChildren fields(node);
                     XmlItem itemData;
                     itemData.itemName = currentComponentName;
-                    itemData.lockHash = node.child("lockHash").child_value();
-                    itemData.textLabel = node.child("textLabel").child_value();
-                    itemData.uniqueNameHash = node.child("uniqueNameHash").child_value();
-                    itemData.localDrawableIndex = node.child("localDrawableIndex").attribute("value").as_string();
-                    itemData.textureIndex = node.child("textureIndex").child_value();
-                    itemData.eCompType = node.child("eCompType").child_value();
+                    itemData.lockHash = Core::intern(fields[Tag::LockHash].child_value());
+                    itemData.textLabel = fields[Tag::TextLabel].child_value();
+                    itemData.uniqueNameHash = fields[Tag::UniqueNameHash].child_value();
+                    itemData.localDrawableIndex = ShopMetaFields::parseItemIndex(fields[Tag::LocalDrawableIndex].attribute("value").as_string(),
+                                                                                 "localDrawableIndex", itemData.uniqueNameHash, numericErrors, *logger);
+                    itemData.textureIndex = ShopMetaFields::parseItemIndex(fields[Tag::TextureIndex].child_value(),
+                                                                           "textureIndex", itemData.uniqueNameHash, numericErrors, *logger);
+                    itemData.eCompType = Core::intern(fields[Tag::CompType].child_value());
+                    appendColumns(fields, itemData.uniqueNameHash, outNode.columns, numericErrors, *logger);
 
                     logger->log("Found item - Name: " + std::string(itemData.itemName) +
                                 ", Hash: " + std::string(itemData.uniqueNameHash) +
@@ -164,7 +546,7 @@ bool XmlParser::parseNode(const pugi::xml_node& xmlNode, XmlNode& outNode) {
 
         // Parse pedProps
         logger->log("Parsing pedProps...");
-        auto propsNode = xmlNode.child("pedProps");
+        auto propsNode = top[Tag::PedProps];
         if (propsNode) {
             std::string_view currentPropName = Core::Defaults::NA;
 
@@ -173,15 +555,19 @@ bool XmlParser::parseNode(const pugi::xml_node& xmlNode, XmlNode& outNode) {
                     currentPropName = node.value();
                     logger->log("Found prop comment: " + std::string(currentPropName));
                 }
-                else if (std::string(node.name()) == "Item") {
+                else if (classifyTag(node.name()) == Tag::Item) {
+                    TagChildren fields(node);
                     XmlItem itemData;
                     itemData.itemName = currentPropName;
-                    itemData.lockHash = node.child("lockHash").child_value();
-                    itemData.textLabel = node.child("textLabel").child_value();
-                    itemData.uniqueNameHash = node.child("uniqueNameHash").child_value();
-                    itemData.propIndex = node.child("propIndex").attribute("value").as_string();
-                    itemData.textureIndex = node.child("textureIndex").child_value();
-                    itemData.eAnchorPoint = node.child("eAnchorPoint").child_value();
+                    itemData.lockHash = Core::intern(fields[Tag::LockHash].child_value());
+                    itemData.textLabel = fields[Tag::TextLabel].child_value();
+                    itemData.uniqueNameHash = fields[Tag::UniqueNameHash].child_value();
+                    itemData.propIndex = ShopMetaFields::parseItemIndex(fields[Tag::PropIndex].attribute("value").as_string(),
+                                                                        "propIndex", itemData.uniqueNameHash, numericErrors, *logger);
+                    itemData.textureIndex = ShopMetaFields::parseItemIndex(fields[Tag::TextureIndex].child_value(),
+                                                                           "textureIndex", itemData.uniqueNameHash, numericErrors, *logger);
+                    itemData.eAnchorPoint = Core::intern(fields[Tag::AnchorPoint].child_value());
+                    appendColumns(fields, itemData.uniqueNameHash, outNode.columns, numericErrors, *logger);
 
                     logger->log("Found prop - Name: " + std::string(itemData.itemName) +
                                 ", Hash: " + std::string(itemData.uniqueNameHash) +
@@ -213,17 +599,134 @@ void XmlParser::categorizeNode(XmlNode& node) {
     }
 }
 
-bool XmlParser::scanDirectory(const std::string& directory) {
-    try {
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
-            if (entry.path().extension() == ".meta") {
-                filePaths.push_back(entry.path().string());
+// Keeps the files whose items belong to a selected DLC: ones that mention a selected
+// dlc_key (item hashes carry it) or whose <dlcName> resolves to a selected DLC, plus the
+// files sharing a text label with those. Every item key in the kept files is recorded
+// in the selection for the script metadata parser. This is a text search over each
+// file, far cheaper than parsing the ones that are dropped.
+bool XmlParser::selectDlcFiles() {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Core::InputFile> inputs(files.size());
+    std::vector<char> keep(files.size(), 0);
+    std::unordered_set<std::string_view> labels;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string error;
+        if (!inputs[i].open(options.bundle.get(), files[i].path, Core::InputFile::Access::ReadOnly, error)) {
+            logger->error(error);
+            return false;
+        }
+
+        std::string_view content = inputs[i].view();
+        std::string_view dlcName = elementText(content, "dlcName").front();
+        keep[i] = options.dlcs->mentionedIn(content) ||
+                  (!dlcName.empty() && options.dlcs->containsName(Core::ComponentUtils::resolveDlcName(dlcName)));
+        if (keep[i]) {
+            for (std::string_view label : elementText(content, "textLabel")) {
+                labels.insert(label);
+            }
+        }
+    }
+
+    size_t direct = std::count(keep.begin(), keep.end(), 1);
+    std::vector<Core::ScannedFile> selected;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string_view content = inputs[i].view();
+        if (!keep[i]) {
+            auto related = elementText(content, "textLabel");
+            keep[i] = std::any_of(related.begin(), related.end(),
+                                  [&](std::string_view label) { return !label.empty() && labels.count(label) > 0; });
+        }
+        if (keep[i]) {
+            for (std::string_view key : elementText(content, "uniqueNameHash")) {
+                options.dlcs->addRelatedKey(key);
             }
+            selected.push_back(std::move(files[i]));
         }
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    logger->log("DLC selection (" + options.dlcs->describe() + "): " + std::to_string(selected.size()) + " of " +
+                std::to_string(files.size()) + " shop meta files (" + std::to_string(direct) + " direct, " +
+                std::to_string(selected.size() - direct) + " sharing text labels), " +
+                std::to_string(options.dlcs->relatedKeyCount()) + " item keys, chosen in " +
+                std::to_string(elapsed.count()) + " ms");
+    files.swap(selected);
+    return true;
+}
+
+size_t XmlParser::compact() {
+    // Labels and hashes repeat across outfits, so each distinct text is copied once;
+    // the low-cardinality fields go to the interning pool like a fresh parse puts them
+    std::unordered_map<std::string_view, std::string_view> copies;
+    auto own = [&](std::string_view& text) {
+        auto [it, inserted] = copies.try_emplace(text);
+        if (inserted) {
+            it->second = compactStrings.store(text);
+        }
+        text = it->second;
+    };
+    auto compactItem = [&](XmlItem& item) {
+        own(item.itemName);
+        own(item.textLabel);
+        own(item.uniqueNameHash);
+        item.lockHash = Core::intern(item.lockHash);
+        item.eCompType = Core::intern(item.eCompType);
+        item.eAnchorPoint = Core::intern(item.eAnchorPoint);
+    };
+
+    for (std::vector<XmlNode>* nodes : { &maleNodes, &femaleNodes }) {
+        for (XmlNode& node : *nodes) {
+            node.pedName = Core::intern(node.pedName);
+            node.dlcName = Core::intern(node.dlcName);
+            node.fullDlcName = Core::intern(node.fullDlcName);
+            for (XmlOutfit& outfit : node.outfits) {
+                own(outfit.outfitName);
+                own(outfit.textLabel);
+                own(outfit.uniqueNameHash);
+                outfit.lockHash = Core::intern(outfit.lockHash);
+                std::for_each(outfit.components.begin(), outfit.components.end(), compactItem);
+                std::for_each(outfit.props.begin(), outfit.props.end(), compactItem);
+            }
+            std::for_each(node.items.begin(), node.items.end(), compactItem);
+
+            // Side-table strings are interned by a parse but may point into the snapshot
+            ShopItemColumns& columns = node.columns;
+            for (std::string_view& shopEnum : columns.shopEnum) {
+                shopEnum = Core::intern(shopEnum);
+            }
+            for (ShopItemListColumn* list : { &columns.restrictionTags, &columns.forcedComponents, &columns.variantComponents }) {
+                for (std::string_view& value : list->values) {
+                    value = Core::intern(value);
+                }
+            }
+        }
+    }
+
+    size_t documentCount = documents.size();
+    std::vector<pugi::xml_document>().swap(documents);
+    std::vector<Core::InputFile>().swap(inputs);
+    std::vector<Core::StringStore>().swap(stringStores);
+    snapshot.reset();
+
+    logger->log("Compacted XML nodes: " + std::to_string(documentCount) + " documents freed, " +
+                std::to_string(copies.size()) + " distinct strings kept (" +
+                std::to_string(compactStrings.size()) + " bytes)");
+    return compactStrings.size();
+}
+
+// Overlays are always read from disk; the base comes from the bundle when there is one
+bool XmlParser::scanDirectory(const std::string& directory, bool overlay) {
+    // An overlay may carry only shop meta or only JSON files
+    std::error_code ec;
+    if (overlay && !std::filesystem::is_directory(directory, ec)) {
         return true;
     }
-    catch (const std::filesystem::filesystem_error& e) {
-        logger->error(std::string("Filesystem error: ") + e.what());
+
+    std::string error;
+    if (!Core::scanInputs(overlay ? nullptr : options.bundle.get(), directory, ".meta", files, error)) {
+        logger->error(error);
         return false;
     }
+    return true;
 } 
\ No newline at end of file
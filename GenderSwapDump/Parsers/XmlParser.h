@@ -1,18 +1,29 @@
 #pragma once
 #include "../Core/Interfaces.h"
+#include "../Core/Constants.h"
+#include "../Core/DlcSelection.h"
+#include "../Core/FileScanner.h"
+#include "../Core/FileStamp.h"
+#include "../Core/InputFile.h"
+#include "../Core/StringStore.h"
+#include "../Core/TarBundle.h"
+#include "XmlDocumentLoader.h"
 #include "pugixml/pugixml.hpp"
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
+class CorpusSnapshot;
+
 struct XmlItem {
     std::string_view itemName;
     std::string_view lockHash;
     std::string_view textLabel;
     std::string_view uniqueNameHash;
-    std::string_view localDrawableIndex;
-    std::string_view propIndex;
-    std::string_view textureIndex;
+    int32_t localDrawableIndex{Core::Defaults::INVALID_ID};  // Index fields are parsed at ingest
+    int32_t propIndex{Core::Defaults::INVALID_ID};
+    int32_t textureIndex{Core::Defaults::INVALID_ID};
     std::string_view eCompType;
     std::string_view eAnchorPoint;
 };
@@ -26,35 +37,167 @@ struct XmlOutfit {
     std::vector<XmlItem> props;
 };
 
+// A list field as one flat array: row i owns values [first(i), first(i) + count(i)).
+// A row is built by adding its values and then calling endRow(); replacing a row
+// appends its new values and leaves the old ones unreferenced.
+struct ShopItemListColumn {
+    std::vector<uint32_t> starts;
+    std::vector<uint32_t> counts;
+    std::vector<std::string_view> values;
+    uint32_t rowStart{0};
+
+    void endRow() {
+        starts.push_back(rowStart);
+        counts.push_back(static_cast<uint32_t>(values.size()) - rowStart);
+        rowStart = static_cast<uint32_t>(values.size());
+    }
+    uint32_t first(size_t row) const { return starts[row]; }
+    uint32_t count(size_t row) const { return counts[row]; }
+
+    void appendRow(const ShopItemListColumn& from, size_t row) {
+        values.insert(values.end(), from.values.begin() + from.first(row),
+                      from.values.begin() + from.first(row) + from.count(row));
+        endRow();
+    }
+    void assignRow(size_t row, const ShopItemListColumn& from, size_t fromRow) {
+        starts[row] = static_cast<uint32_t>(values.size());
+        counts[row] = from.count(fromRow);
+        values.insert(values.end(), from.values.begin() + from.first(fromRow),
+                      from.values.begin() + from.first(fromRow) + from.count(fromRow));
+        rowStart = static_cast<uint32_t>(values.size());
+    }
+};
+
+// Shop item fields the reports do not use, captured in the same pass as XmlNode::items
+// with one array per field; row i describes items[i]. Strings are interned.
+struct ShopItemColumns {
+    std::vector<int32_t> cost;
+    std::vector<int32_t> drawableIndex;  // Global drawable, unlike XmlItem::localDrawableIndex
+    std::vector<std::string_view> shopEnum;
+    ShopItemListColumn restrictionTags;    // tagNameHash of each entry
+    ShopItemListColumn forcedComponents;   // nameHash of each entry
+    ShopItemListColumn variantComponents;  // nameHash of each entry
+
+    size_t rows() const { return cost.size(); }
+
+    void appendRow(const ShopItemColumns& from, size_t row) {
+        cost.push_back(from.cost[row]);
+        drawableIndex.push_back(from.drawableIndex[row]);
+        shopEnum.push_back(from.shopEnum[row]);
+        restrictionTags.appendRow(from.restrictionTags, row);
+        forcedComponents.appendRow(from.forcedComponents, row);
+        variantComponents.appendRow(from.variantComponents, row);
+    }
+    void assignRow(size_t row, const ShopItemColumns& from, size_t fromRow) {
+        cost[row] = from.cost[fromRow];
+        drawableIndex[row] = from.drawableIndex[fromRow];
+        shopEnum[row] = from.shopEnum[fromRow];
+        restrictionTags.assignRow(row, from.restrictionTags, fromRow);
+        forcedComponents.assignRow(row, from.forcedComponents, fromRow);
+        variantComponents.assignRow(row, from.variantComponents, fromRow);
+    }
+};
+
 struct XmlNode {
     std::string_view pedName;
     std::string_view dlcName;
     std::string_view fullDlcName;
     std::vector<XmlOutfit> outfits;
     std::vector<XmlItem> items;
+    ShopItemColumns columns;
+};
+
+struct XmlParserOptions {
+    unsigned threadCount{1};  // Worker threads for loading shop meta files, 0 = one per core
+    XmlIngestMode ingestMode{XmlIngestMode::File};
+    std::shared_ptr<Core::TarBundle> bundle;  // Read xmlfiles/ members from this archive instead of the disk
+    std::shared_ptr<Core::DlcSelection> dlcs;  // Load only these DLCs' files (and related ones), recording their item keys
+    std::vector<std::string> overlays;  // Directories whose xmlfiles/ override earlier layers by uniqueNameHash, in order
 };
 
 class XmlParser : public Core::IParser {
 private:
     std::shared_ptr<Core::ILogger> logger;
-    std::vector<std::string> filePaths;
-    std::vector<pugi::xml_document> documents;
+    XmlParserOptions options;
+    std::vector<Core::ScannedFile> files;  // Base layer first, then each overlay
+    std::vector<Core::InputFile> inputs;  // Backing storage for in-place documents
+    std::vector<pugi::xml_document> documents;   // Empty in Pull mode
+    std::vector<Core::StringStore> stringStores;  // Decoded values that could not alias the input
+    Core::StringStore compactStrings;  // Sole owner of node text after compact()
     std::vector<XmlNode> maleNodes;
     std::vector<XmlNode> femaleNodes;
+    size_t numericErrors{0};  // Index fields that were not valid integers
+    std::shared_ptr<CorpusSnapshot> snapshot;  // Previous run's results; owns the strings of reused nodes
+    size_t reusedFiles{0};
     bool valid{false};
 
+    // Where an item or outfit with a given uniqueNameHash was filed. Only kept when there
+    // are overlays: each kept node is indexed as it arrives, so resolving an overlay
+    // file costs a lookup per item in that file.
+    struct HashTarget {
+        std::vector<XmlNode>* nodes;
+        uint32_t node;
+        uint32_t index;
+        bool outfit;
+    };
+    std::unordered_map<std::string_view, HashTarget> hashIndex;
+    size_t baseFileCount{0};   // files before this are the base layer, the rest overlays
+    size_t overriddenItems{0};
+
+    // Everything one file contributes, filled independently so files can load concurrently
+    struct LoadedFile {
+        Core::InputFile input;
+        pugi::xml_document doc;
+        Core::StringStore strings;
+        XmlNode node;
+        size_t numericErrors{0};
+        Core::FileStamp stamp;
+        bool reused{false};  // Node came from the snapshot, the file was not read
+    };
+
 public:
-    explicit XmlParser(std::shared_ptr<Core::ILogger> logger);
+    explicit XmlParser(std::shared_ptr<Core::ILogger> logger, XmlParserOptions options = {});
     
     bool parse() override;
     bool isValid() const override { return valid; }
+
+    // Reuse a previous run's nodes for files that have not changed since; call before parse()
+    void reuseFrom(std::shared_ptr<CorpusSnapshot> snapshot) { this->snapshot = std::move(snapshot); }
     
     const std::vector<XmlNode>& getMaleNodes() const { return maleNodes; }
     const std::vector<XmlNode>& getFemaleNodes() const { return femaleNodes; }
+    size_t getNumericErrorCount() const { return numericErrors; }
+
+    // Copy the text the nodes borrow from documents, mappings and the snapshot into one
+    // owned store, then free all of those; returns the bytes kept. Call after parse()
+    // once nothing needs the DOMs (the snapshot writer only reads the nodes).
+    size_t compact();
+
+    // Where each input file's node was filed, for the snapshot writer
+    struct FileResult {
+        std::string path;
+        Core::FileStamp stamp;
+        size_t numericErrors{0};
+        const std::vector<XmlNode>* nodes{nullptr};  // maleNodes, femaleNodes, or null if not kept
+        size_t nodeIndex{0};
+    };
+    const std::vector<FileResult>& getFileResults() const { return fileResults; }
+    size_t getReusedFileCount() const { return reusedFiles; }
+    size_t getOverriddenItemCount() const { return overriddenItems; }
 
 private:
-    bool loadXmlFile(const std::string& path);
-    bool scanDirectory(const std::string& directory);
-    bool parseNode(const pugi::xml_node& node, XmlNode& outNode);
+    std::vector<FileResult> fileResults;
+
+    bool acquireFile(const std::string& path, LoadedFile& file);
+    bool loadXmlFile(const std::string& path, LoadedFile& file);
+    bool extractXmlFile(const std::string& path, LoadedFile& file);
+    void keepFile(const Core::ScannedFile& input, LoadedFile& file, bool overlay);
+    void applyOverlay(XmlNode& node);
+    void indexNode(std::vector<XmlNode>* nodes, size_t nodeIndex);
+    bool loadFilesSerial();
+    bool loadFilesParallel(unsigned threads);
+    bool scanDirectory(const std::string& directory, bool overlay = false);
+    bool selectDlcFiles();
+    bool parseNode(const pugi::xml_node& node, XmlNode& outNode, size_t& numericErrors);
     void categorizeNode(XmlNode& node);
 }; 
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "XmlPullReader.h"
+#include <cstring>
+#include <string>
+
+namespace {
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool isNameEnd(char c) {
+        return isSpace(c) || c == '/' || c == '>' || c == '=';
+    }
+
+    void appendCodePoint(std::string& out, unsigned long cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        }
+        else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // Decode one entity starting at '&'; returns the number of bytes consumed,
+    // or 0 when it is not a recognised entity (pugixml leaves those untouched)
+    size_t decodeEntity(std::string_view text, size_t at, std::string& out) {
+        size_t semicolon = text.find(';', at);
+        if (semicolon == std::string_view::npos) {
+            return 0;
+        }
+
+        std::string_view entity = text.substr(at + 1, semicolon - at - 1);
+        if (entity == "lt") out += '<';
+        else if (entity == "gt") out += '>';
+        else if (entity == "amp") out += '&';
+        else if (entity == "quot") out += '"';
+        else if (entity == "apos") out += '\'';
+        else if (entity.size() > 1 && entity[0] == '#') {
+            bool hex = entity[1] == 'x';
+            std::string_view digits = entity.substr(hex ? 2 : 1);
+            if (digits.empty()) {
+                return 0;
+            }
+            unsigned long cp = 0;
+            for (char c : digits) {
+                unsigned digit;
+                if (c >= '0' && c <= '9') digit = c - '0';
+                else if (hex && c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+                else if (hex && c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+                else return 0;
+                cp = cp * (hex ? 16 : 10) + digit;
+            }
+            appendCodePoint(out, cp);
+        }
+        else {
+            return 0;
+        }
+        return semicolon - at + 1;
+    }
+}
+
+XmlPullReader::XmlPullReader(const char* data, size_t size)
+    : begin(data)
+    , pos(data)
+    , end(data + size)
+{
+    // Skip a UTF-8 byte order mark
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        pos += 3;
+    }
+}
+
+XmlPullReader::Event XmlPullReader::next() {
+    if (errorPos) {
+        return Event::Error;
+    }
+
+    while (pos < end) {
+        cdata = false;
+
+        if (*pos != '<') {
+            const char* textStart = pos;
+            const char* textEnd = static_cast<const char*>(std::memchr(pos, '<', end - pos));
+            pos = textEnd ? textEnd : end;
+
+            const char* c = textStart;
+            while (c < pos && isSpace(*c)) {
+                ++c;
+            }
+            if (c == pos) {
+                continue;
+            }
+
+            currentValue = std::string_view(textStart, pos - textStart);
+            return Event::Text;
+        }
+
+        if (startsWith("<!--")) {
+            const char* close = find("-->", pos + 4);
+            if (!close) {
+                return fail("unterminated comment", pos);
+            }
+            currentValue = std::string_view(pos + 4, close - (pos + 4));
+            pos = close + 3;
+            return Event::Comment;
+        }
+
+        if (startsWith("<![CDATA[")) {
+            const char* close = find("]]>", pos + 9);
+            if (!close) {
+                return fail("unterminated CDATA section", pos);
+            }
+            currentValue = std::string_view(pos + 9, close - (pos + 9));
+            cdata = true;
+            pos = close + 3;
+            return Event::Text;
+        }
+
+        if (startsWith("<?")) {
+            const char* close = find("?>", pos + 2);
+            if (!close) {
+                return fail("unterminated processing instruction", pos);
+            }
+            pos = close + 2;
+            continue;
+        }
+
+        if (startsWith("<!")) {
+            // DOCTYPE and friends; an internal subset may contain '>' inside brackets
+            const char* start = pos;
+            int brackets = 0;
+            for (pos += 2; pos < end; ++pos) {
+                if (*pos == '[') ++brackets;
+                else if (*pos == ']') --brackets;
+                else if (*pos == '>' && brackets <= 0) break;
+            }
+            if (pos >= end) {
+                return fail("unterminated declaration", start);
+            }
+            ++pos;
+            continue;
+        }
+
+        if (startsWith("</")) {
+            return readEndElement();
+        }
+
+        return readStartElement();
+    }
+
+    if (!openElements.empty()) {
+        return fail("unexpected end of document", end);
+    }
+    return Event::EndOfDocument;
+}
+
+bool XmlPullReader::skipElement() {
+    if (emptyElement) {
+        return true;
+    }
+
+    size_t targetDepth = openElements.size() - 1;
+    while (openElements.size() > targetDepth) {
+        Event event = next();
+        if (event == Event::Error || event == Event::EndOfDocument) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view XmlPullReader::attribute(std::string_view attributeName) const {
+    size_t cursor = 0;
+    std::string_view currentAttribute;
+    std::string_view value;
+    while (nextAttribute(cursor, currentAttribute, value)) {
+        if (currentAttribute == attributeName) {
+            return value;
+        }
+    }
+    return std::string_view();
+}
+
+bool XmlPullReader::nextAttribute(size_t& cursor, std::string_view& attributeName, std::string_view& value) const {
+    size_t i = cursor;
+    while (i < attributes.size() && isSpace(attributes[i])) {
+        ++i;
+    }
+
+    size_t nameStart = i;
+    while (i < attributes.size() && !isNameEnd(attributes[i])) {
+        ++i;
+    }
+    if (i == nameStart) {
+        return false;
+    }
+    attributeName = attributes.substr(nameStart, i - nameStart);
+
+    while (i < attributes.size() && isSpace(attributes[i])) {
+        ++i;
+    }
+    if (i >= attributes.size() || attributes[i] != '=') {
+        return false;
+    }
+    ++i;
+    while (i < attributes.size() && isSpace(attributes[i])) {
+        ++i;
+    }
+    if (i >= attributes.size() || (attributes[i] != '"' && attributes[i] != '\'')) {
+        return false;
+    }
+
+    char quote = attributes[i++];
+    size_t valueEnd = attributes.find(quote, i);
+    if (valueEnd == std::string_view::npos) {
+        return false;
+    }
+
+    value = attributes.substr(i, valueEnd - i);
+    cursor = valueEnd + 1;
+    return true;
+}
+
+std::string_view XmlPullReader::decode(std::string_view raw, Core::StringStore& strings, bool escapes) {
+    bool needsWork = raw.find('\r') != std::string_view::npos ||
+                     (escapes && raw.find('&') != std::string_view::npos);
+    if (!needsWork) {
+        return raw;
+    }
+
+    std::string out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c == '\r') {
+            out += '\n';
+            if (i + 1 < raw.size() && raw[i + 1] == '\n') {
+                ++i;
+            }
+        }
+        else if (c == '&' && escapes) {
+            size_t consumed = decodeEntity(raw, i, out);
+            if (consumed == 0) {
+                out += c;
+            }
+            else {
+                i += consumed - 1;
+            }
+        }
+        else {
+            out += c;
+        }
+    }
+    return strings.store(out);
+}
+
+XmlPullReader::Event XmlPullReader::fail(std::string_view message, const char* at) {
+    error = message;
+    errorPos = at;
+    return Event::Error;
+}
+
+bool XmlPullReader::startsWith(std::string_view prefix) const {
+    return static_cast<size_t>(end - pos) >= prefix.size() &&
+           std::memcmp(pos, prefix.data(), prefix.size()) == 0;
+}
+
+const char* XmlPullReader::find(std::string_view terminator, const char* from) const {
+    std::string_view rest(from, end - from);
+    size_t found = rest.find(terminator);
+    return found == std::string_view::npos ? nullptr : from + found;
+}
+
+XmlPullReader::Event XmlPullReader::readStartElement() {
+    const char* tagStart = pos;
+    const char* nameStart = ++pos;
+    while (pos < end && !isNameEnd(*pos)) {
+        ++pos;
+    }
+    if (pos == nameStart) {
+        return fail("missing element name", tagStart);
+    }
+    currentName = std::string_view(nameStart, pos - nameStart);
+
+    // Find the closing '>' while stepping over quoted attribute values
+    const char* attributesStart = pos;
+    char quote = 0;
+    for (; pos < end; ++pos) {
+        if (quote) {
+            if (*pos == quote) quote = 0;
+        }
+        else if (*pos == '"' || *pos == '\'') {
+            quote = *pos;
+        }
+        else if (*pos == '>') {
+            break;
+        }
+    }
+    if (pos >= end) {
+        return fail("unterminated start tag", tagStart);
+    }
+
+    emptyElement = pos > attributesStart && pos[-1] == '/';
+    const char* attributesEnd = emptyElement ? pos - 1 : pos;
+    attributes = std::string_view(attributesStart, attributesEnd - attributesStart);
+    ++pos;
+
+    if (!emptyElement) {
+        openElements.push_back(currentName);
+    }
+    return Event::StartElement;
+}
+
+XmlPullReader::Event XmlPullReader::readEndElement() {
+    const char* tagStart = pos;
+    const char* nameStart = pos + 2;
+    pos = nameStart;
+    while (pos < end && !isNameEnd(*pos)) {
+        ++pos;
+    }
+    currentName = std::string_view(nameStart, pos - nameStart);
+
+    while (pos < end && isSpace(*pos)) {
+        ++pos;
+    }
+    if (pos >= end || *pos != '>') {
+        return fail("malformed end tag", tagStart);
+    }
+    ++pos;
+
+    if (openElements.empty() || openElements.back() != currentName) {
+        return fail("mismatched end tag", tagStart);
+    }
+    openElements.pop_back();
+    emptyElement = false;
+    return Event::EndElement;
+}
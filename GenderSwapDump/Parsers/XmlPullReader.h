@@ -0,0 +1,68 @@
+#pragma once
+#include "../Core/StringStore.h"
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+// Minimal forward-only XML tokenizer over an in-memory buffer.
+// Nothing is allocated per node: names, attribute values, text and comments are
+// views into the buffer, still escaped. decode() turns a raw view into the value
+// pugixml would report (parse_escapes | parse_eol), copying only when it has to.
+class XmlPullReader {
+public:
+    enum class Event {
+        StartElement,    // name(), attribute(); isEmptyElement() for <x/>, which has no EndElement
+        EndElement,      // name()
+        Text,            // value(); whitespace-only runs between tags are skipped
+        Comment,         // value()
+        EndOfDocument,
+        Error            // errorMessage(), errorOffset()
+    };
+
+    XmlPullReader(const char* data, size_t size);
+
+    Event next();
+
+    // Skip the rest of the element just started, including everything nested in it
+    bool skipElement();
+
+    std::string_view name() const { return currentName; }
+    std::string_view value() const { return currentValue; }
+    bool isEmptyElement() const { return emptyElement; }
+    bool isCData() const { return cdata; }
+    size_t depth() const { return openElements.size(); }
+
+    // Raw value of an attribute on the current start tag, empty if it is not present
+    std::string_view attribute(std::string_view attributeName) const;
+
+    // Walk the current start tag's attributes in document order; start with cursor = 0
+    bool nextAttribute(size_t& cursor, std::string_view& attributeName, std::string_view& value) const;
+
+    std::string_view errorMessage() const { return error; }
+    size_t errorOffset() const { return static_cast<size_t>(errorPos - begin); }
+    size_t offset() const { return static_cast<size_t>(pos - begin); }
+
+    // Resolve entities and normalise line endings; returns `raw` itself when neither occurs
+    static std::string_view decode(std::string_view raw, Core::StringStore& strings, bool escapes = true);
+
+private:
+    const char* begin;
+    const char* pos;
+    const char* end;
+
+    std::vector<std::string_view> openElements;
+    std::string_view currentName;
+    std::string_view currentValue;
+    std::string_view attributes;  // Raw text between the tag name and '>' / '/>'
+    bool emptyElement{false};
+    bool cdata{false};
+
+    std::string_view error;
+    const char* errorPos{nullptr};
+
+    Event fail(std::string_view message, const char* at);
+    bool startsWith(std::string_view prefix) const;
+    const char* find(std::string_view terminator, const char* from) const;
+    Event readStartElement();
+    Event readEndElement();
+};
@@ -1,9 +1,28 @@
 #include "ClothingProcessor.h"
+#include "../Core/ComponentClassifier.h"
 #include "../Core/Constants.h"
+#include "../Core/FileScanner.h"
+#include "../Core/ModelIds.h"
+#include "../Core/StringPool.h"
 #include <algorithm>
 #include <stdexcept>
 #include <cctype>
 
+namespace {
+    constexpr Core::ComponentTypes::ComponentId UNKNOWN_TYPE = Core::ComponentTypes::componentId("UNKNOWN");
+
+    // JSON items carry the file's short type ("JBIB"). ClothingItem::comp holds the row it
+    // belongs to, as for script metadata items, rather than the short type text
+    Core::ComponentTypes::ComponentId itemComponent(std::string_view shortType) {
+        const auto* mapping = Core::ComponentUtils::findUnifiedComponent(shortType);
+        return mapping ? Core::ComponentTypes::componentId(*mapping) : Core::ModelIds::componentOfDisplayName(shortType);
+    }
+
+    Core::DlcInfo::DlcId resolveDlc(std::string_view uniqueNameHash, std::string_view fallbackInput) {
+        return Core::ModelIds::dlcOfName(Core::ComponentUtils::resolveDlcFromHash(uniqueNameHash, fallbackInput));
+    }
+}
+
 ClothingProcessor::ClothingProcessor(
     std::shared_ptr<Core::ILogger> logger,
     std::shared_ptr<JsonParser> jsonParser,
@@ -65,7 +84,7 @@ void ClothingProcessor::processJsonData() {
     
     for (const auto& jsonItem : jsonParser->getItems()) {
         // Determine if this is male or female based on filename
-        bool isFemale = std::string(jsonItem.filename).find("female") != std::string::npos;
+        bool isFemale = Core::inputGender(jsonItem.filename) == Core::InputGender::Female;
         
         // Try to find existing item by GXT label (textLabel)
         Core::ClothingItem* existingItem = findExistingItemByGXT(jsonItem.GXT, isFemale);
@@ -79,44 +98,32 @@ void ClothingProcessor::processJsonData() {
             }
             
             // Update component details with JSON data (prioritize JSON over XML)
-            if (!jsonItem.drawableId.empty()) {
-                try {
-                    int jsonDrawableId = std::stoi(std::string(jsonItem.drawableId));
-                    if (existingItem->componentDetails.drawableId != jsonDrawableId) {
-                        if (existingItem->componentDetails.drawableId != -1) {
-                            logger->log("DrawableID mismatch for " + std::string(existingItem->m_key) + 
-                                       ": XML=" + std::to_string(existingItem->componentDetails.drawableId) + 
-                                       ", JSON=" + std::to_string(jsonDrawableId) + " - Using JSON value");
-                        }
-                        // Prioritize JSON data over XML data
-                        existingItem->componentDetails.drawableId = jsonDrawableId;
-                    }
-                } catch (const std::exception& e) {
-                    logger->error("Failed to parse JSON drawableId for " + std::string(jsonItem.GXT));
+            if (jsonItem.drawableId != Core::Defaults::INVALID_ID &&
+                existingItem->componentDetails.drawableId != jsonItem.drawableId) {
+                if (existingItem->componentDetails.drawableId != -1) {
+                    logger->log("DrawableID mismatch for " + std::string(existingItem->m_key) + 
+                               ": XML=" + std::to_string(existingItem->componentDetails.drawableId) + 
+                               ", JSON=" + std::to_string(jsonItem.drawableId) + " - Using JSON value");
                 }
+                // Prioritize JSON data over XML data
+                existingItem->componentDetails.drawableId = jsonItem.drawableId;
             }
             
-            if (!jsonItem.textureId.empty()) {
-                try {
-                    int jsonTextureId = std::stoi(std::string(jsonItem.textureId));
-                    if (existingItem->componentDetails.textureId != jsonTextureId) {
-                        if (existingItem->componentDetails.textureId != -1) {
-                            logger->log("TextureID mismatch for " + std::string(existingItem->m_key) + 
-                                       ": XML=" + std::to_string(existingItem->componentDetails.textureId) + 
-                                       ", JSON=" + std::to_string(jsonTextureId) + " - Using JSON value");
-                        }
-                        // Prioritize JSON data over XML data
-                        existingItem->componentDetails.textureId = jsonTextureId;
-                    }
-                } catch (const std::exception& e) {
-                    logger->error("Failed to parse JSON textureId for " + std::string(jsonItem.GXT));
+            if (jsonItem.textureId != Core::Defaults::INVALID_ID &&
+                existingItem->componentDetails.textureId != jsonItem.textureId) {
+                if (existingItem->componentDetails.textureId != -1) {
+                    logger->log("TextureID mismatch for " + std::string(existingItem->m_key) + 
+                               ": XML=" + std::to_string(existingItem->componentDetails.textureId) + 
+                               ", JSON=" + std::to_string(jsonItem.textureId) + " - Using JSON value");
                 }
+                // Prioritize JSON data over XML data
+                existingItem->componentDetails.textureId = jsonItem.textureId;
             }
             
             logger->log("Enriched existing item: " + std::string(existingItem->m_key) + 
                        " | TextLabel: " + std::string(existingItem->m_textlabel) + 
                        " | Name: " + std::string(existingItem->itemName) +
-                       " | Type: " + existingItem->componentDetails.componentType +
+                       " | Type: " + std::string(Core::ModelIds::componentType(existingItem->componentDetails.component)) +
                        " | DrawableID: " + std::to_string(existingItem->componentDetails.drawableId) +
                        " | TextureID: " + std::to_string(existingItem->componentDetails.textureId));
         } else {
@@ -132,7 +139,7 @@ void ClothingProcessor::processJsonData() {
             clothingItem.m_key = jsonItem.GXT;  // Use GXT as key if no script metadata
             clothingItem.itemName = jsonItem.localized;
             clothingItem.componentDetails = componentDetails;
-            clothingItem.comp = jsonItem.component;
+            clothingItem.comp = itemComponent(jsonItem.component);
             
             if (isFemale) {
                 clothingItem.m_gender = Core::GenderIdentifiers::FEMALE_STR;
@@ -144,7 +151,7 @@ void ClothingProcessor::processJsonData() {
             
             logger->log("Created standalone JSON item: " + std::string(jsonItem.GXT) + 
                        " | Name: " + std::string(jsonItem.localized) +
-                       " | Type: " + componentDetails.componentType +
+                       " | Type: " + std::string(Core::ModelIds::componentType(componentDetails.component)) +
                        " | DrawableID: " + std::to_string(componentDetails.drawableId) +
                        " | TextureID: " + std::to_string(componentDetails.textureId));
         }
@@ -202,10 +209,10 @@ void ClothingProcessor::processXmlNode(const XmlNode& node, bool isMale) {
         if (existingItem != nullptr) {
             // Update only missing information
             if (existingItem->itemName.empty() && !item.itemName.empty()) {
-                existingItem->itemName = std::string(item.itemName);
+                existingItem->itemName = Core::intern(item.itemName);
             }
-            if (existingItem->dlcName.empty()) {
-                existingItem->dlcName = Core::ComponentUtils::resolveDlcFromHash(std::string(item.uniqueNameHash), node.dlcName);
+            if (existingItem->dlc == Core::DlcInfo::NO_DLC) {
+                existingItem->dlc = resolveDlc(item.uniqueNameHash, node.dlcName);
             }
             continue;
         }
@@ -214,20 +221,20 @@ void ClothingProcessor::processXmlNode(const XmlNode& node, bool isMale) {
         Core::ClothingItem clothingItem;
         clothingItem.m_textlabel = item.textLabel;
         clothingItem.m_key = item.uniqueNameHash;
-        clothingItem.dlcName = Core::ComponentUtils::resolveDlcFromHash(std::string(item.uniqueNameHash), node.dlcName);
-        clothingItem.itemName = std::string(item.itemName);
+        clothingItem.dlc = resolveDlc(item.uniqueNameHash, node.dlcName);
+        clothingItem.itemName = Core::intern(item.itemName);
         
         // Create component details using unified processor
         Core::ComponentDetails details = ComponentProcessor::createComponentDetails(
-            std::string(item.eCompType),
-            std::string(item.uniqueNameHash),
-            std::string(item.localDrawableIndex),
-            std::string(item.textureIndex),
-            std::string(node.dlcName)
+            item.eCompType,
+            item.uniqueNameHash,
+            item.localDrawableIndex,
+            item.textureIndex,
+            node.dlcName
         );
         
         // Enhance with JSON data (JSON takes priority)
-        ComponentProcessor::enrichWithJsonData(details, std::string(item.textLabel), jsonParser->getItems());
+        ComponentProcessor::enrichWithJsonData(details, item.textLabel, *jsonParser);
         
         clothingItem.componentDetails = details;
         
@@ -248,7 +255,7 @@ std::shared_ptr<Core::Outfit> ClothingProcessor::processOutfit(const XmlOutfit&
     auto outfit = std::make_shared<Core::Outfit>();
     outfit->outfitHash = std::string(outfitData.uniqueNameHash);
     outfit->localizedName = std::string(outfitData.outfitName);
-    outfit->dlcName = std::string(dlcName);
+    outfit->dlc = Core::ModelIds::dlcOfName(dlcName);
     
     // Extract textLabel for the outfit itself
     std::string outfitHash = std::string(outfitData.uniqueNameHash);
@@ -313,21 +320,21 @@ void ClothingProcessor::processOutfitComponents(std::shared_ptr<Core::Outfit> ou
         } else {
             // Create component details using unified processor
             Core::ComponentDetails details = ComponentProcessor::createComponentDetails(
-                std::string(comp.eCompType),
-                std::string(comp.uniqueNameHash),
-                std::string(comp.localDrawableIndex),
-                std::string(comp.textureIndex),
-                outfit->dlcName
+                comp.eCompType,
+                comp.uniqueNameHash,
+                comp.localDrawableIndex,
+                comp.textureIndex,
+                Core::ModelIds::dlcName(outfit->dlc)
             );
             
             // Enhance with JSON data (JSON takes priority)
-            ComponentProcessor::enrichWithJsonData(details, outfitComp->textLabel, jsonParser->getItems());
+            ComponentProcessor::enrichWithJsonData(details, outfitComp->textLabel, *jsonParser);
             
             outfitComp->details = details;
         }
         
         logger->log("[outfit components] : " + outfitComp->componentHash + 
-                   " | Type: " + outfitComp->details.componentType +
+                   " | Type: " + std::string(Core::ModelIds::componentType(outfitComp->details.component)) +
                    " | TextLabel: " + outfitComp->textLabel +
                    " | Localized: " + outfitComp->localizedName);
         outfit->components.push_back(outfitComp);
@@ -349,14 +356,14 @@ void ClothingProcessor::processScriptMetaData() {
         clothingItem.value = metaItem.value;
         clothingItem.m_gender = Core::GenderIdentifiers::MALE_STR;
         clothingItem.comp = metaItem.comp;
-        clothingItem.dlcName = metaItem.dlcName;
+        clothingItem.dlc = metaItem.dlc;
         
         std::string hashKey = std::string(metaItem.m_key);
         
         // Extract textLabel from pre-built mapping
         auto textLabelIt = hashToTextLabelMap.find(hashKey);
         if (textLabelIt != hashToTextLabelMap.end()) {
-            clothingItem.m_textlabel = textLabelIt->second;
+            clothingItem.m_textlabel = Core::intern(textLabelIt->second);
             logger->log("Linked script metadata " + hashKey + 
                        " with textLabel: " + textLabelIt->second);
         } else {
@@ -368,23 +375,23 @@ void ClothingProcessor::processScriptMetaData() {
         if (detailsIt != hashToComponentDetailsMap.end()) {
             clothingItem.componentDetails = detailsIt->second;
             // Override DLC name from script metadata if available
-            if (!metaItem.dlcName.empty()) {
-                clothingItem.componentDetails.dlcName = std::string(metaItem.dlcName);
-                clothingItem.dlcName = metaItem.dlcName;
+            if (metaItem.dlc != Core::DlcInfo::NO_DLC) {
+                clothingItem.componentDetails.dlc = metaItem.dlc;
+                clothingItem.dlc = metaItem.dlc;
             }
         } else {
             // Create component details using unified processor
             Core::ComponentDetails details = ComponentProcessor::createComponentDetails(
-                std::string(metaItem.comp),
+                Core::ModelIds::componentDisplayName(metaItem.comp),
                 hashKey,
-                "", // No drawable index from script
-                "", // No texture index from script
-                std::string(metaItem.dlcName)
+                Core::Defaults::INVALID_ID, // No drawable index from script
+                Core::Defaults::INVALID_ID, // No texture index from script
+                Core::ModelIds::dlcName(metaItem.dlc)
             );
             
             // Enhance with JSON data if textLabel is available
             if (!clothingItem.m_textlabel.empty()) {
-                ComponentProcessor::enrichWithJsonData(details, std::string(clothingItem.m_textlabel), jsonParser->getItems());
+                ComponentProcessor::enrichWithJsonData(details, clothingItem.m_textlabel, *jsonParser);
             }
             
             clothingItem.componentDetails = details;
@@ -394,7 +401,7 @@ void ClothingProcessor::processScriptMetaData() {
         logger->log("Added male item: " + hashKey + 
                    " | Value: " + std::string(metaItem.value) + 
                    " | TextLabel: " + std::string(clothingItem.m_textlabel) +
-                   " | Type: " + clothingItem.componentDetails.componentType +
+                   " | Type: " + std::string(Core::ModelIds::componentType(clothingItem.componentDetails.component)) +
                    " | DrawableID: " + std::to_string(clothingItem.componentDetails.drawableId) +
                    " | TextureID: " + std::to_string(clothingItem.componentDetails.textureId));
     }
@@ -406,14 +413,14 @@ void ClothingProcessor::processScriptMetaData() {
         clothingItem.value = metaItem.value;
         clothingItem.m_gender = Core::GenderIdentifiers::FEMALE_STR;
         clothingItem.comp = metaItem.comp;
-        clothingItem.dlcName = metaItem.dlcName;
+        clothingItem.dlc = metaItem.dlc;
         
         std::string hashKey = std::string(metaItem.m_key);
         
         // Extract textLabel from pre-built mapping
         auto textLabelIt = hashToTextLabelMap.find(hashKey);
         if (textLabelIt != hashToTextLabelMap.end()) {
-            clothingItem.m_textlabel = textLabelIt->second;
+            clothingItem.m_textlabel = Core::intern(textLabelIt->second);
             logger->log("Linked script metadata " + hashKey + 
                        " with textLabel: " + textLabelIt->second);
         } else {
@@ -425,23 +432,23 @@ void ClothingProcessor::processScriptMetaData() {
         if (detailsIt != hashToComponentDetailsMap.end()) {
             clothingItem.componentDetails = detailsIt->second;
             // Override DLC name from script metadata if available
-            if (!metaItem.dlcName.empty()) {
-                clothingItem.componentDetails.dlcName = std::string(metaItem.dlcName);
-                clothingItem.dlcName = metaItem.dlcName;
+            if (metaItem.dlc != Core::DlcInfo::NO_DLC) {
+                clothingItem.componentDetails.dlc = metaItem.dlc;
+                clothingItem.dlc = metaItem.dlc;
             }
         } else {
             // Create component details using unified processor
             Core::ComponentDetails details = ComponentProcessor::createComponentDetails(
-                std::string(metaItem.comp),
+                Core::ModelIds::componentDisplayName(metaItem.comp),
                 hashKey,
-                "", // No drawable index from script
-                "", // No texture index from script
-                std::string(metaItem.dlcName)
+                Core::Defaults::INVALID_ID, // No drawable index from script
+                Core::Defaults::INVALID_ID, // No texture index from script
+                Core::ModelIds::dlcName(metaItem.dlc)
             );
             
             // Enhance with JSON data if textLabel is available
             if (!clothingItem.m_textlabel.empty()) {
-                ComponentProcessor::enrichWithJsonData(details, std::string(clothingItem.m_textlabel), jsonParser->getItems());
+                ComponentProcessor::enrichWithJsonData(details, clothingItem.m_textlabel, *jsonParser);
             }
             
             clothingItem.componentDetails = details;
@@ -451,7 +458,7 @@ void ClothingProcessor::processScriptMetaData() {
         logger->log("Added female item: " + hashKey + 
                    " | Value: " + std::string(metaItem.value) + 
                    " | TextLabel: " + std::string(clothingItem.m_textlabel) +
-                   " | Type: " + clothingItem.componentDetails.componentType +
+                   " | Type: " + std::string(Core::ModelIds::componentType(clothingItem.componentDetails.component)) +
                    " | DrawableID: " + std::to_string(clothingItem.componentDetails.drawableId) +
                    " | TextureID: " + std::to_string(clothingItem.componentDetails.textureId));
     }
@@ -468,7 +475,7 @@ void ClothingProcessor::processScriptMetaData() {
 
 void ClothingProcessor::addItemToCollection(Core::ClothingCollection& collection, 
                                           const Core::ClothingItem& item) {
-    collection.items.push_back(item);
+    collection.add(item);
 }
 
 void ClothingProcessor::addOutfitToCollection(Core::ClothingCollection& collection, 
@@ -478,7 +485,7 @@ void ClothingProcessor::addOutfitToCollection(Core::ClothingCollection& collecti
 
 // Function removed - replaced with ComponentProcessor::extractComponentType
 
-std::string ClothingProcessor::determineComponentType(const std::string& rawType) {
+Core::ComponentTypes::ComponentId ClothingProcessor::determineComponentType(std::string_view rawType) {
     // Use the unified component processor
     return ComponentProcessor::extractComponentType(rawType);
 }
@@ -486,21 +493,21 @@ std::string ClothingProcessor::determineComponentType(const std::string& rawType
 
 
 // Query methods implementation
-std::vector<std::shared_ptr<Core::Outfit>> ClothingProcessor::getOutfitsByDLC(const std::string& dlcName) const {
+std::vector<std::shared_ptr<Core::Outfit>> ClothingProcessor::getOutfitsByDLC(Core::DlcInfo::DlcId dlc) const {
     std::vector<std::shared_ptr<Core::Outfit>> results;
     for (const auto& [_, outfit] : outfitCache) {
-        if (outfit->dlcName == dlcName) {
+        if (outfit->dlc == dlc) {
             results.push_back(outfit);
         }
     }
     return results;
 }
 
-std::vector<Core::ClothingItem> ClothingProcessor::getItemsByComponent(const std::string& componentType) const {
+std::vector<Core::ClothingItem> ClothingProcessor::getItemsByComponent(Core::ComponentTypes::ComponentId component) const {
     std::vector<Core::ClothingItem> results;
     auto processCollection = [&](const Core::ClothingCollection& collection) {
         for (const auto& item : collection.items) {
-            if (item.componentDetails.componentType == componentType) {
+            if (item.componentDetails.component == component) {
                 results.push_back(item);
             }
         }
@@ -511,11 +518,11 @@ std::vector<Core::ClothingItem> ClothingProcessor::getItemsByComponent(const std
     return results;
 }
 
-std::vector<Core::ClothingItem> ClothingProcessor::getItemsByDLC(const std::string& dlcName) const {
+std::vector<Core::ClothingItem> ClothingProcessor::getItemsByDLC(Core::DlcInfo::DlcId dlc) const {
     std::vector<Core::ClothingItem> results;
     auto processCollection = [&](const Core::ClothingCollection& collection) {
         for (const auto& item : collection.items) {
-            if (item.componentDetails.dlcName == dlcName) {
+            if (item.componentDetails.dlc == dlc) {
                 results.push_back(item);
             }
         }
@@ -531,12 +538,7 @@ std::vector<Core::ClothingItem> ClothingProcessor::getItemsByDLC(const std::stri
 // Helper method to find existing item
 Core::ClothingItem* ClothingProcessor::findExistingItem(std::string_view key, bool isMale) {
     auto& collection = isMale ? genderData.male : genderData.female;
-    for (auto& item : collection.items) {
-        if (item.m_key == key) {
-            return &item;
-        }
-    }
-    return nullptr;
+    return collection.findByKey(key);
 }
 
 // Helper method to find item by GXT label
@@ -552,16 +554,9 @@ Core::ClothingItem* ClothingProcessor::findExistingItemByGXT(std::string_view gx
                "' in " + (isFemale ? "female" : "male") + 
                " collection with " + std::to_string(collection.items.size()) + " items");
     
-    for (auto& item : collection.items) {
-        // Add safety check for m_textlabel
-        if (item.m_textlabel.empty()) {
-            continue; // Skip items with empty textlabels
-        }
-        
-        if (item.m_textlabel == gxtLabel) {
-            logger->log("Found match: " + std::string(item.m_key) + " -> " + std::string(item.m_textlabel));
-            return &item;
-        }
+    if (Core::ClothingItem* item = collection.findByTextLabel(gxtLabel)) {
+        logger->log("Found match: " + std::string(item->m_key) + " -> " + std::string(item->m_textlabel));
+        return item;
     }
     
     logger->log("No match found for GXT: " + std::string(gxtLabel));
@@ -570,61 +565,35 @@ Core::ClothingItem* ClothingProcessor::findExistingItemByGXT(std::string_view gx
 
 Core::ComponentDetails ClothingProcessor::processComponentDetails(const JsonItem& jsonItem) {
     Core::ComponentDetails details;
-    details.componentType = determineComponentType(std::string(jsonItem.component));
+    details.component = determineComponentType(jsonItem.component);
     
-    try {
-        // Process drawable ID
-        if (!jsonItem.drawableId.empty()) {
-            try {
-                details.drawableId = std::stoi(std::string(jsonItem.drawableId));
-            }
-            catch (const std::exception& e) {
-                details.drawableId = -1;
-                logger->error("Failed to parse drawableId for item " + std::string(jsonItem.GXT));
-            }
-        }
+    // IDs were validated when the JSON was parsed
+    details.drawableId = jsonItem.drawableId;
+    details.textureId = jsonItem.textureId;
 
-        // Process texture ID
-        if (!jsonItem.textureId.empty()) {
-            try {
-                details.textureId = std::stoi(std::string(jsonItem.textureId));
-            }
-            catch (const std::exception& e) {
-                details.textureId = -1;
-                logger->error("Failed to parse textureId for item " + std::string(jsonItem.GXT));
-            }
-        }
+    //// Set DLC name if available
+    //if (!jsonItem.dlcName.empty()) {
+    //    details.dlcName = std::string(jsonItem.dlcName);
+    //}
 
-        //// Set DLC name if available
-        //if (!jsonItem.dlcName.empty()) {
-        //    details.dlcName = std::string(jsonItem.dlcName);
-        //}
-
-        return details;
-    }
-    catch (const std::exception& e) {
-        logger->error("Exception in processComponentDetails: " + std::string(e.what()));
-        return details;
-    }
+    return details;
 }
 
 void ClothingProcessor::updateItemCaches(const Core::ClothingItem& item) {
     // Update DLC cache
-    if (!item.dlcName.empty()) {
-        auto dlcIt = cache.dlcItems.find(std::string(item.dlcName));
-        if (dlcIt == cache.dlcItems.end()) {
-            cache.dlcItems[std::string(item.dlcName)] = std::vector<std::string>();
+    if (item.dlc != Core::DlcInfo::NO_DLC) {
+        if (cache.dlcItems.size() <= item.dlc) {
+            cache.dlcItems.resize(item.dlc + 1);
         }
-        cache.dlcItems[std::string(item.dlcName)].push_back(std::string(item.m_key));
+        cache.dlcItems[item.dlc].push_back(std::string(item.m_key));
     }
     
     // Update component cache
-    if (!item.comp.empty()) {
-        auto compIt = cache.componentItems.find(std::string(item.comp));
-        if (compIt == cache.componentItems.end()) {
-            cache.componentItems[std::string(item.comp)] = std::vector<std::string>();
+    if (item.comp != Core::ComponentTypes::NO_COMPONENT) {
+        if (cache.componentItems.size() <= item.comp) {
+            cache.componentItems.resize(item.comp + 1);
         }
-        cache.componentItems[std::string(item.comp)].push_back(std::string(item.m_key));
+        cache.componentItems[item.comp].push_back(std::string(item.m_key));
     }
 }
 
@@ -662,48 +631,29 @@ void ClothingProcessor::buildTextLabelMappings() {
                 
                 // Map component details
                 Core::ComponentDetails details;
-                details.componentType = determineComponentType(std::string(item.eCompType));
+                details.component = determineComponentType(item.eCompType);
                 
                 // If component type is unknown, try to extract from uniqueNameHash
-                if (details.componentType == "UNKNOWN" || details.componentType.empty()) {
-                    std::string extractedType = ComponentProcessor::extractComponentType("", hashKey);
-                    if (extractedType != "UNKNOWN") {
-                        details.componentType = extractedType;
+                if (details.component == UNKNOWN_TYPE || details.component == Core::ComponentTypes::NO_COMPONENT) {
+                    Core::ComponentTypes::ComponentId extractedType = ComponentProcessor::extractComponentType("", hashKey);
+                    if (extractedType != UNKNOWN_TYPE) {
+                        details.component = extractedType;
                         logger->log("Enhanced mapping component type detection for " + hashKey + 
-                                   ": " + std::string(item.eCompType) + " -> " + extractedType + 
+                                   ": " + std::string(item.eCompType) + " -> " + std::string(Core::ModelIds::componentType(extractedType)) + 
                                    " (from hash: " + hashKey + ")");
                     }
                 }
                 
-                // Extract drawable and texture IDs from XML
-                if (!item.localDrawableIndex.empty()) {
-                    try {
-                        details.drawableId = std::stoi(std::string(item.localDrawableIndex));
-                    } catch (const std::exception& e) {
-                        details.drawableId = -1;
-                        logger->error("Failed to parse localDrawableIndex for " + hashKey + ": " + e.what());
-                    }
-                } else {
-                    details.drawableId = -1;
-                }
-                
-                if (!item.textureIndex.empty()) {
-                    try {
-                        details.textureId = std::stoi(std::string(item.textureIndex));
-                    } catch (const std::exception& e) {
-                        details.textureId = -1;
-                        logger->error("Failed to parse textureIndex for " + hashKey + ": " + e.what());
-                    }
-                } else {
-                    details.textureId = -1;
-                }
+                // Drawable and texture IDs were parsed with the XML (INVALID_ID if absent)
+                details.drawableId = item.localDrawableIndex;
+                details.textureId = item.textureIndex;
                 
                 // Extract DLC name from uniqueNameHash, fallback to node dlcName
-                details.dlcName = Core::ComponentUtils::resolveDlcFromHash(hashKey, node.dlcName);
+                details.dlc = resolveDlc(hashKey, node.dlcName);
                 
                 hashToComponentDetailsMap[hashKey] = details;
                 logger->log("Mapped hash to component details: " + hashKey + 
-                           " -> Type: " + details.componentType + 
+                           " -> Type: " + std::string(Core::ModelIds::componentType(details.component)) + 
                            ", DrawableID: " + std::to_string(details.drawableId) + 
                            ", TextureID: " + std::to_string(details.textureId));
             }
@@ -725,48 +675,29 @@ void ClothingProcessor::buildTextLabelMappings() {
                 
                 // Map component details
                 Core::ComponentDetails details;
-                details.componentType = determineComponentType(std::string(item.eCompType));
+                details.component = determineComponentType(item.eCompType);
                 
                 // If component type is unknown, try to extract from uniqueNameHash
-                if (details.componentType == "UNKNOWN" || details.componentType.empty()) {
-                    std::string extractedType = ComponentProcessor::extractComponentType("", hashKey);
-                    if (extractedType != "UNKNOWN") {
-                        details.componentType = extractedType;
+                if (details.component == UNKNOWN_TYPE || details.component == Core::ComponentTypes::NO_COMPONENT) {
+                    Core::ComponentTypes::ComponentId extractedType = ComponentProcessor::extractComponentType("", hashKey);
+                    if (extractedType != UNKNOWN_TYPE) {
+                        details.component = extractedType;
                         logger->log("Enhanced mapping component type detection for " + hashKey + 
-                                   ": " + std::string(item.eCompType) + " -> " + extractedType + 
+                                   ": " + std::string(item.eCompType) + " -> " + std::string(Core::ModelIds::componentType(extractedType)) + 
                                    " (from hash: " + hashKey + ")");
                     }
                 }
                 
-                // Extract drawable and texture IDs from XML
-                if (!item.localDrawableIndex.empty()) {
-                    try {
-                        details.drawableId = std::stoi(std::string(item.localDrawableIndex));
-                    } catch (const std::exception& e) {
-                        details.drawableId = -1;
-                        logger->error("Failed to parse localDrawableIndex for " + hashKey + ": " + e.what());
-                    }
-                } else {
-                    details.drawableId = -1;
-                }
-                
-                if (!item.textureIndex.empty()) {
-                    try {
-                        details.textureId = std::stoi(std::string(item.textureIndex));
-                    } catch (const std::exception& e) {
-                        details.textureId = -1;
-                        logger->error("Failed to parse textureIndex for " + hashKey + ": " + e.what());
-                    }
-                } else {
-                    details.textureId = -1;
-                }
+                // Drawable and texture IDs were parsed with the XML (INVALID_ID if absent)
+                details.drawableId = item.localDrawableIndex;
+                details.textureId = item.textureIndex;
                 
                 // Extract DLC name from uniqueNameHash, fallback to node dlcName
-                details.dlcName = Core::ComponentUtils::resolveDlcFromHash(hashKey, node.dlcName);
+                details.dlc = resolveDlc(hashKey, node.dlcName);
                 
                 hashToComponentDetailsMap[hashKey] = details;
                 logger->log("Mapped hash to component details: " + hashKey + 
-                           " -> Type: " + details.componentType + 
+                           " -> Type: " + std::string(Core::ModelIds::componentType(details.component)) + 
                            ", DrawableID: " + std::to_string(details.drawableId) + 
                            ", TextureID: " + std::to_string(details.textureId));
             }
@@ -778,68 +709,32 @@ void ClothingProcessor::buildTextLabelMappings() {
 }
 
 std::string ClothingProcessor::getLocalizedNameFromTextLabel(const std::string& textLabel) {
-    if (textLabel.empty() || textLabel == "NO_LABEL") {
-        return "";
-    }
-    
-    // Search through all JSON items to find matching GXT text label
-    const auto& jsonItems = jsonParser->getItems();
-    for (const auto& item : jsonItems) {
-        if (std::string(item.GXT) == textLabel) {
-            std::string localized = std::string(item.localized);
-            if (!localized.empty() && localized != "NULL" && localized != "NO_LABEL") {
-                return localized;
-            }
-        }
-    }
-    
-    // If not found in JSON items, return empty string
-    return "";
+    // The first JSON item with this GXT that carries a real localized name
+    const JsonItem* item = jsonParser->findNamedByGxt(textLabel);
+    return item ? std::string(item->localized) : std::string();
 }
 
 // Unified ComponentProcessor implementation
-std::string ClothingProcessor::ComponentProcessor::extractComponentType(const std::string& rawType, const std::string& uniqueNameHash) {
+Core::ComponentTypes::ComponentId ClothingProcessor::ComponentProcessor::extractComponentType(std::string_view rawType, std::string_view uniqueNameHash) {
     // First, try the unified component mapping with rawType
     auto* mapping = Core::ComponentUtils::findUnifiedComponent(rawType);
     if (mapping) {
-        return std::string(mapping->internalType);
+        return Core::ComponentTypes::componentId(*mapping);
     }
     
-    // If no mapping found and we have a hash, try hash extraction
-    if (!uniqueNameHash.empty()) {
-        std::string hash = uniqueNameHash;
-        std::transform(hash.begin(), hash.end(), hash.begin(), ::toupper);
-        
-        // Look for known component patterns in the hash
-        for (const auto& comp : Core::ComponentTypes::UNIFIED_COMPONENTS) {
-            if (!comp.shortType.empty()) {
-                std::string pattern = "_" + std::string(comp.shortType);
-                size_t pos = hash.find(pattern);
-                if (pos != std::string::npos) {
-                    // Verify boundary
-                    size_t nextPos = pos + pattern.length();
-                    if (nextPos >= hash.length() || hash[nextPos] == '_' || 
-                        hash[nextPos] == '0' || std::isdigit(hash[nextPos])) {
-                        return std::string(comp.internalType);
-                    }
-                }
-            }
-        }
-        
-        // Check for outfit patterns
-        if (hash.find("_OUTFIT") != std::string::npos || hash.find("OUTFIT_") != std::string::npos) {
-            return "OUTFIT";
-        }
+    // If no mapping found, look for known component patterns in the hash
+    if (const auto* comp = Core::ComponentClassifier::instance().classifyHash(uniqueNameHash)) {
+        return Core::ComponentTypes::componentId(*comp);
     }
     
     // Fallback to uppercase rawType if not empty
     if (!rawType.empty()) {
-        std::string result = rawType;
+        std::string result(rawType);
         std::transform(result.begin(), result.end(), result.begin(), ::toupper);
-        return result;
+        return Core::ModelIds::componentOfType(result);
     }
     
-    return "UNKNOWN";
+    return UNKNOWN_TYPE;
 }
 
 std::string ClothingProcessor::ComponentProcessor::resolveDlcName(const std::string& rawDlcName) {
@@ -847,78 +742,47 @@ std::string ClothingProcessor::ComponentProcessor::resolveDlcName(const std::str
 }
 
 Core::ComponentDetails ClothingProcessor::ComponentProcessor::createComponentDetails(
-    const std::string& eCompType, 
-    const std::string& uniqueNameHash,
-    const std::string& drawableIndex,
-    const std::string& textureIndex,
-    const std::string& dlcName) {
+    std::string_view eCompType, 
+    std::string_view uniqueNameHash,
+    int32_t drawableIndex,
+    int32_t textureIndex,
+    std::string_view dlcName) {
     
     Core::ComponentDetails details;
-    details.componentType = extractComponentType(eCompType, uniqueNameHash);
-    details.dlcName = Core::ComponentUtils::resolveDlcFromHash(uniqueNameHash, dlcName);
-    
-    // Parse drawable ID
-    if (!drawableIndex.empty()) {
-        try {
-            details.drawableId = std::stoi(drawableIndex);
-        } catch (const std::exception&) {
-            details.drawableId = -1;
-        }
-    } else {
-        details.drawableId = -1;
-    }
+    details.component = extractComponentType(eCompType, uniqueNameHash);
+    details.dlc = resolveDlc(uniqueNameHash, dlcName);
     
-    // Parse texture ID  
-    if (!textureIndex.empty()) {
-        try {
-            details.textureId = std::stoi(textureIndex);
-        } catch (const std::exception&) {
-            details.textureId = -1;
-        }
-    } else {
-        details.textureId = -1;
-    }
+    details.drawableId = drawableIndex;
+    details.textureId = textureIndex;
     
     return details;
 }
 
 void ClothingProcessor::ComponentProcessor::enrichWithJsonData(Core::ComponentDetails& details, 
-                                                             const std::string& textLabel,
-                                                             const std::vector<JsonItem>& jsonItems) {
-    if (textLabel.empty() || textLabel == "NO_LABEL") return;
-    
+                                                             std::string_view textLabel,
+                                                             const JsonParser& json) {
     // Find matching JSON data and prioritize it over XML data
-    for (const auto& item : jsonItems) {
-        if (std::string(item.GXT) == textLabel) {
-            // JSON data takes priority over XML data
-            if (!item.drawableId.empty()) {
-                try {
-                    int jsonDrawableId = std::stoi(std::string(item.drawableId));
-                    if (jsonDrawableId >= 0) {
-                        details.drawableId = jsonDrawableId;
-                    }
-                } catch (const std::exception&) {}
-            }
-            
-            if (!item.textureId.empty()) {
-                try {
-                    int jsonTextureId = std::stoi(std::string(item.textureId));
-                    if (jsonTextureId >= 0) {
-                        details.textureId = jsonTextureId;
-                    }
-                } catch (const std::exception&) {}
-            }
-            
-            // Add localized variant
-            std::string localized = std::string(item.localized);
-            if (!localized.empty() && localized != "NULL" && localized != "NO_LABEL") {
-                Core::ComponentVariant variant;
-                variant.textureId = details.textureId;
-                variant.localizedName = localized;
-                variant.isDefault = true;
-                details.variants.push_back(variant);
-            }
-            break;
-        }
+    const JsonItem* item = json.findByGxt(textLabel);
+    if (!item) {
+        return;
+    }
+
+    // JSON data takes priority over XML data
+    if (item->drawableId >= 0) {
+        details.drawableId = item->drawableId;
+    }
+
+    if (item->textureId >= 0) {
+        details.textureId = item->textureId;
+    }
+
+    // Add localized variant
+    if (!item->localized.empty() && item->localized != Core::Defaults::NULL_NAME &&
+        item->localized != Core::Defaults::NO_LABEL) {
+        Core::ComponentVariant variant;
+        variant.textureId = details.textureId;
+        variant.localizedName = std::string(item->localized);
+        variant.isDefault = true;
+        details.variants.push_back(variant);
     }
 } 
\ No newline at end of file
@@ -17,21 +17,21 @@ private:
 
     // Simplified caching structure
     struct ProcessingCache {
-        std::unordered_map<std::string, std::vector<std::string>> dlcItems;
-        std::unordered_map<std::string, std::vector<std::string>> componentItems;
+        std::vector<std::vector<std::string>> dlcItems;        // Item keys by ClothingItem::dlc
+        std::vector<std::vector<std::string>> componentItems;  // Item keys by ClothingItem::comp
     } cache;
 
     // Unified processing utility for reducing redundancy
     struct ComponentProcessor {
-        static std::string extractComponentType(const std::string& rawType, const std::string& uniqueNameHash = "");
+        static Core::ComponentTypes::ComponentId extractComponentType(std::string_view rawType, std::string_view uniqueNameHash = {});
         static std::string resolveDlcName(const std::string& rawDlcName);
-        static Core::ComponentDetails createComponentDetails(const std::string& eCompType, 
-                                                           const std::string& uniqueNameHash,
-                                                           const std::string& drawableIndex = "",
-                                                           const std::string& textureIndex = "",
-                                                           const std::string& dlcName = "");
-        static void enrichWithJsonData(Core::ComponentDetails& details, const std::string& textLabel,
-                                     const std::vector<JsonItem>& jsonItems);
+        static Core::ComponentDetails createComponentDetails(std::string_view eCompType, 
+                                                           std::string_view uniqueNameHash,
+                                                           int32_t drawableIndex = Core::Defaults::INVALID_ID,
+                                                           int32_t textureIndex = Core::Defaults::INVALID_ID,
+                                                           std::string_view dlcName = {});
+        static void enrichWithJsonData(Core::ComponentDetails& details, std::string_view textLabel,
+                                     const JsonParser& json);
     };
 
     // Storage for processed items
@@ -62,7 +62,7 @@ private:
     // Helper methods
     void addItemToCollection(Core::ClothingCollection& collection, const Core::ClothingItem& item);
     void addOutfitToCollection(Core::ClothingCollection& collection, std::shared_ptr<Core::Outfit> outfit);
-    std::string determineComponentType(const std::string& rawType);
+    Core::ComponentTypes::ComponentId determineComponentType(std::string_view rawType);
 
     Core::ClothingItem* findExistingItem(std::string_view textLabel, bool isMale);
     Core::ClothingItem* findExistingItemByGXT(std::string_view gxtLabel, bool isFemale);
@@ -81,7 +81,7 @@ public:
     const Core::GenderSpecificData& getProcessedData() const { return genderData; }
     
     // Query methods
-    std::vector<std::shared_ptr<Core::Outfit>> getOutfitsByDLC(const std::string& dlcName) const;
-        std::vector<Core::ClothingItem> getItemsByComponent(const std::string& componentType) const;
-    std::vector<Core::ClothingItem> getItemsByDLC(const std::string& dlcName) const;
+    std::vector<std::shared_ptr<Core::Outfit>> getOutfitsByDLC(Core::DlcInfo::DlcId dlc) const;
+        std::vector<Core::ClothingItem> getItemsByComponent(Core::ComponentTypes::ComponentId component) const;
+    std::vector<Core::ClothingItem> getItemsByDLC(Core::DlcInfo::DlcId dlc) const;
 }; 
\ No newline at end of file
@@ -1,14 +1,20 @@
 #pragma once
 #include "Core/Logger.h"
 #include "Core/Constants.h"
+#include "Core/DlcSelection.h"
+#include "Core/ProcessMemory.h"
+#include "Core/StringPool.h"
 #include "Parsers/JsonParser.h"
 #include "Parsers/XmlParser.h"
 #include "Parsers/ScriptMetadataParser.h"
+#include "Parsers/CorpusSnapshot.h"
 #include "Processors/ClothingProcessor.h"
 #include "Output/ClothingDumper.h"
 #include <memory>
 #include <iostream>
 #include <filesystem>
+#include <charconv>
+#include <chrono>
 
 namespace fs = std::filesystem;
 
@@ -17,6 +23,113 @@ struct Config {
 	fs::path outputDir{"output"};
 	std::string mainDumpFile{"clothing_dump.txt"};
 	std::string logFile{"clothing_dump.log"};
+	std::string snapshotFile{"corpus.snapshot"};
+	bool useSnapshot{true};
+	bool compact{false};  // Free the parsers' XML documents once the corpus is loaded
+	std::string bundlePath;  // Read every input from this tar archive instead of the directories
+	std::shared_ptr<Core::DlcSelection> dlcs;  // Only these DLCs' reports are regenerated; null means all
+	JsonParserOptions jsonOptions;
+	XmlParserOptions xmlOptions;
+	ScriptMetadataParserOptions scriptOptions;
+	
+	// Parse command line switches; returns false on an unknown or malformed one
+	bool parseArgs(int argc, char* argv[]) {
+		for (int i = 1; i < argc; ++i) {
+			std::string_view arg = argv[i];
+			
+			if (arg == "--json-ingest=stream") {
+				jsonOptions.ingestMode = JsonIngestMode::Stream;
+			}
+			else if (arg == "--json-ingest=mmap") {
+				jsonOptions.ingestMode = JsonIngestMode::MemoryMapped;
+			}
+			else if (arg == "--json-ingest=sax") {
+				jsonOptions.ingestMode = JsonIngestMode::Sax;
+			}
+			else if (arg == "--json-validate=off") {
+				jsonOptions.validation = JsonValidation::Off;
+			}
+			else if (arg == "--json-validate=report") {
+				jsonOptions.validation = JsonValidation::Report;
+			}
+			else if (arg == "--json-validate=fail-fast") {
+				jsonOptions.validation = JsonValidation::FailFast;
+			}
+			else if (arg == "--xml-ingest=file") {
+				xmlOptions.ingestMode = XmlIngestMode::File;
+				scriptOptions.ingestMode = XmlIngestMode::File;
+			}
+			else if (arg == "--xml-ingest=mmap") {
+				xmlOptions.ingestMode = XmlIngestMode::MemoryMapped;
+				scriptOptions.ingestMode = XmlIngestMode::MemoryMapped;
+			}
+			else if (arg == "--xml-ingest=pull") {
+				xmlOptions.ingestMode = XmlIngestMode::Pull;
+				scriptOptions.ingestMode = XmlIngestMode::Pull;
+			}
+			else if (arg.substr(0, 9) == "--bundle=") {
+				bundlePath = std::string(arg.substr(9));
+				if (bundlePath.empty()) {
+					std::cerr << "Missing bundle path" << std::endl;
+					return false;
+				}
+			}
+			else if (arg == "--no-snapshot") {
+				useSnapshot = false;
+			}
+			else if (arg == "--compact") {
+				compact = true;
+			}
+			else if (arg.substr(0, 10) == "--overlay=") {
+				// Repeatable; each directory holds xmlfiles/ and/or Jsonfiles/ layered over the earlier ones
+				std::string overlay(arg.substr(10));
+				if (!fs::is_directory(overlay)) {
+					std::cerr << "Overlay directory not found: " << overlay << std::endl;
+					return false;
+				}
+				xmlOptions.overlays.push_back(overlay);
+				jsonOptions.overlays.push_back(overlay);
+			}
+			else if (arg.substr(0, 6) == "--dlc=") {
+				// Comma-separated dlc_key, dlcFileName or display name values
+				if (!dlcs) {
+					dlcs = std::make_shared<Core::DlcSelection>();
+					xmlOptions.dlcs = dlcs;
+					scriptOptions.dlcs = dlcs;
+				}
+				std::string_view list = arg.substr(6);
+				while (!list.empty()) {
+					size_t comma = list.find(',');
+					std::string_view dlc = list.substr(0, comma);
+					if (!dlcs->add(dlc)) {
+						std::cerr << "Unknown DLC: " << dlc << std::endl;
+						return false;
+					}
+					list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+				}
+				if (dlcs->empty()) {
+					std::cerr << "Missing DLC list" << std::endl;
+					return false;
+				}
+			}
+			else if (arg.substr(0, 10) == "--threads=") {
+				std::string_view value = arg.substr(10);
+				unsigned threads = 0;
+				auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), threads);
+				if (ec != std::errc() || end != value.data() + value.size()) {
+					std::cerr << "Invalid thread count: " << value << std::endl;
+					return false;
+				}
+				xmlOptions.threadCount = threads;
+				jsonOptions.threadCount = threads;
+			}
+			else {
+				std::cerr << "Unknown option: " << arg << std::endl;
+				return false;
+			}
+		}
+		return true;
+	}
 	
 	void ensureOutputDir() {
 		if (!fs::exists(outputDir)) {
@@ -40,6 +153,15 @@ bool validateParsers(
 	
 	logger->log("Validating parsers...");
 	
+	// Shop meta files go first: a DLC selection learns from them which script
+	// metadata items it needs
+	if (!xmlParser->parse()) {
+		logger->error("Failed to parse XML files");
+		valid = false;
+	} else {
+		logger->log("XML files parsed successfully");
+	}
+	
 	if (!scriptParser->parse()) {
 		logger->error("Failed to parse script metadata");
 		valid = false;
@@ -54,14 +176,60 @@ bool validateParsers(
 		logger->log("JSON files parsed successfully");
 	}
 	
-	if (!xmlParser->parse()) {
-		logger->error("Failed to parse XML files");
-		valid = false;
-	} else {
-		logger->log("XML files parsed successfully");
+	return valid;
+}
+
+// Parse the inputs, reusing the previous run's per-file results from the snapshot for
+// every file that has not changed, then rewrite the snapshot if anything was re-parsed
+bool loadCorpus(
+	std::shared_ptr<ScriptMetadataParser> scriptParser,
+	std::shared_ptr<JsonParser> jsonParser,
+	std::shared_ptr<XmlParser> xmlParser,
+	const Config& config,
+	std::shared_ptr<Core::ILogger> logger) {
+	
+	auto start = std::chrono::steady_clock::now();
+	std::string snapshotPath = config.getOutputPath(config.snapshotFile).string();
+	
+	auto snapshot = std::make_shared<CorpusSnapshot>(logger, config.jsonOptions.bundle);
+	bool haveSnapshot = config.useSnapshot && snapshot->load(snapshotPath);
+	if (haveSnapshot) {
+		scriptParser->reuseFrom(snapshot);
+		jsonParser->reuseFrom(snapshot);
+		xmlParser->reuseFrom(snapshot);
 	}
 	
-	return valid;
+	if (!validateParsers(scriptParser, jsonParser, xmlParser, logger)) {
+		return false;
+	}
+	
+	size_t totalFiles = jsonParser->getFileResults().size() + xmlParser->getFileResults().size() + 1;
+	size_t reusedFiles = jsonParser->getReusedFileCount() + xmlParser->getReusedFileCount() +
+		(scriptParser->wasReused() ? 1 : 0);
+	std::string elapsed = std::to_string(std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count());
+	
+	if (reusedFiles == 0) {
+		logger->log("Cold start: " + std::to_string(totalFiles) + " files parsed in " + elapsed + " ms");
+	}
+	else if (reusedFiles == totalFiles) {
+		logger->log("Warm start: all " + std::to_string(totalFiles) + " files reused from snapshot in " + elapsed + " ms");
+	}
+	else {
+		logger->log("Incremental start: " + std::to_string(reusedFiles) + " files reused, " +
+					std::to_string(totalFiles - reusedFiles) + " re-parsed in " + elapsed + " ms");
+	}
+	
+	// Rewrite when a file was added, changed, removed or touched; a failed write only costs
+	// the next run its reuse. A DLC-scoped run loaded only part of the corpus and overlays
+	// rewrite base nodes in place, so both keep the snapshot of the last plain full run.
+	bool upToDate = haveSnapshot && reusedFiles == totalFiles && snapshot->fileCount() == totalFiles &&
+		snapshot->touchedFileCount() == 0;
+	bool layered = !config.xmlOptions.overlays.empty();
+	if (config.useSnapshot && !upToDate && !config.dlcs && !layered) {
+		CorpusSnapshot::write(snapshotPath, *jsonParser, *xmlParser, *scriptParser, *logger);
+	}
+	return true;
 }
 
 void dumpDlcSpecificData(
@@ -74,7 +242,7 @@ void dumpDlcSpecificData(
 	logger->log("Processing DLC: " + std::string(dlc.name));
 	
 	// Dump outfits by DLC
-	auto outfits = processor->getOutfitsByDLC(std::string(dlc.name));
+	auto outfits = processor->getOutfitsByDLC(Core::DlcInfo::dlcId(dlc));
 	if (!outfits.empty()) {
 		std::string filename = "outfits_" + std::string(dlc.dlcFileName) + ".txt";
 		if (!dumper->dumpOutfitsByDLC(outfits, config.getOutputPath(filename).string())) {
@@ -83,7 +251,7 @@ void dumpDlcSpecificData(
 	}
 	
 	// Dump items by DLC with enhanced formatting
-	auto items = processor->getItemsByDLC(std::string(dlc.name));
+	auto items = processor->getItemsByDLC(Core::DlcInfo::dlcId(dlc));
 	if (!items.empty()) {
 		std::string filename = "items_" + std::string(dlc.dlcFileName) + ".txt";
 		if (!dumper->dumpItemsByDLC(items, config.getOutputPath(filename).string())) {
@@ -101,7 +269,7 @@ void dumpComponentSpecificData(
 	
 	logger->log("Processing component type: " + std::string(comp.displayName));
 	
-	auto items = processor->getItemsByComponent(std::string(comp.internalType));
+	auto items = processor->getItemsByComponent(Core::ComponentTypes::componentId(comp));
 	if (!items.empty()) {
 		std::string filename = "items_" + std::string(comp.internalType) + ".txt";
 		if (!dumper->dumpItemsByComponent(items, config.getOutputPath(filename).string())) {
@@ -110,10 +278,13 @@ void dumpComponentSpecificData(
 	}
 }
 
-int main()
+int main(int argc, char* argv[])
 {
 	try {
 		Config config;
+		if (!config.parseArgs(argc, argv)) {
+			return 1;
+		}
 		config.ensureOutputDir();
 
 		// Initialize logger with enhanced formatting
@@ -121,16 +292,42 @@ int main()
 			config.getOutputPath(config.logFile).string());
 		logger->log("Application started");
 
+		// One mapping serves every parser; directory scans become index lookups
+		if (!config.bundlePath.empty()) {
+			auto bundle = std::make_shared<Core::TarBundle>();
+			std::string error;
+			if (!bundle->open(config.bundlePath, error)) {
+				logger->error("Failed to open input bundle: " + error);
+				return 1;
+			}
+			logger->log("Input bundle " + config.bundlePath + ": " + std::to_string(bundle->memberCount()) +
+						" members, " + std::to_string(bundle->size()) + " bytes");
+			config.jsonOptions.bundle = bundle;
+			config.xmlOptions.bundle = bundle;
+			config.scriptOptions.bundle = bundle;
+		}
+
 		// Initialize parsers
-		auto scriptParser = std::make_shared<ScriptMetadataParser>(logger);
-		auto jsonParser = std::make_shared<JsonParser>(logger);
-		auto xmlParser = std::make_shared<XmlParser>(logger);
+		auto scriptParser = std::make_shared<ScriptMetadataParser>(logger, config.scriptOptions);
+		auto jsonParser = std::make_shared<JsonParser>(logger, config.jsonOptions);
+		auto xmlParser = std::make_shared<XmlParser>(logger, config.xmlOptions);
 
-		// Validate all parsers
-		if (!validateParsers(scriptParser, jsonParser, xmlParser, logger)) {
+		// Parse the corpus, or restore it from the snapshot of a previous run
+		if (!loadCorpus(scriptParser, jsonParser, xmlParser, config, logger)) {
 			return 1;
 		}
 
+		// Nothing after loading reads the DOMs, only the text the nodes point into
+		if (config.compact) {
+			auto megabytes = [](size_t bytes) { return std::to_string(bytes / (1024.0 * 1024.0)); };
+			size_t before = Core::residentBytes();
+			size_t kept = xmlParser->compact() + scriptParser->compact();
+			Core::releaseFreeHeapMemory();
+			size_t after = Core::residentBytes();
+			logger->log("Compaction kept " + std::to_string(kept) + " bytes of text; resident memory " +
+						megabytes(before) + " MB -> " + megabytes(after) + " MB");
+		}
+
 		// Initialize processor
 		auto processor = std::make_shared<ClothingProcessor>(
 			logger, jsonParser, xmlParser, scriptParser);
@@ -143,9 +340,25 @@ int main()
 			return 1;
 		}
 		
+		const auto& pool = Core::StringPool::global();
+		logger->log("Interned strings: " + std::to_string(pool.count()) + " (" +
+					std::to_string(pool.bytes()) + " bytes)");
+		
 		// Initialize dumper
 		auto dumper = std::make_shared<Output::ClothingDumper>(logger);
 		
+		// Only the selected DLCs were loaded, so the corpus-wide reports would be partial
+		if (config.dlcs) {
+			logger->log("Regenerating reports for " + config.dlcs->describe() + " only");
+			for (const auto& dlc : Core::DlcInfo::DLC_LIST) {
+				if (config.dlcs->containsName(dlc.name)) {
+					dumpDlcSpecificData(dumper, processor, dlc, config, logger);
+				}
+			}
+			logger->log("Successfully completed DLC-scoped processing and dumps");
+			return 0;
+		}
+		
 		// Main dump file
 		logger->log("Creating main dump file...");
 		if (!dumper->dumpToFile(processor->getProcessedData(), 
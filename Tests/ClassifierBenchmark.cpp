@@ -0,0 +1,160 @@
+#include "ClassifierBenchmark.h"
+#include "Core/ComponentClassifier.h"
+#include "Core/InputFile.h"
+#include "Parsers/JsonParser.h"
+#include "Parsers/ScriptMetadataParser.h"
+#include "Parsers/XmlParser.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <string>
+
+namespace Tests {
+    namespace {
+        using Core::ComponentClassifier;
+        using Core::ComponentTypes::UNIFIED_COMPONENTS;
+
+        // The detectors as they were before ComponentClassifier, kept as the reference
+
+        std::string_view legacyKey(std::string_view key) {
+            for (const auto& comp : UNIFIED_COMPONENTS) {
+                if (key.find(comp.legacyInFiles) != std::string_view::npos) {
+                    return comp.displayName;
+                }
+            }
+            return {};
+        }
+
+        std::string_view legacyHash(std::string_view uniqueNameHash) {
+            if (uniqueNameHash.empty()) {
+                return {};
+            }
+            std::string hash(uniqueNameHash);
+            std::transform(hash.begin(), hash.end(), hash.begin(), ::toupper);
+            for (const auto& comp : UNIFIED_COMPONENTS) {
+                if (!comp.shortType.empty()) {
+                    std::string pattern = "_" + std::string(comp.shortType);
+                    size_t pos = hash.find(pattern);
+                    if (pos != std::string::npos) {
+                        size_t nextPos = pos + pattern.length();
+                        if (nextPos >= hash.length() || hash[nextPos] == '_' ||
+                            hash[nextPos] == '0' || std::isdigit(static_cast<unsigned char>(hash[nextPos]))) {
+                            return comp.internalType;
+                        }
+                    }
+                }
+            }
+            if (hash.find("_OUTFIT") != std::string::npos || hash.find("OUTFIT_") != std::string::npos) {
+                return "OUTFIT";
+            }
+            return {};
+        }
+
+        std::string_view legacyFileName(std::string_view filename) {
+            auto contains = [filename](std::string_view part) { return filename.find(part) != std::string_view::npos; };
+            if (contains("accessories")) return "ACCS";
+            if (contains("hair")) return "HAIR";
+            if (contains("legs")) return "LEGS";
+            if (contains("shoes")) return "FEET";
+            if (contains("tops")) return "JBIB";
+            if (contains("torsos")) return "TORSO";
+            if (contains("undershirts")) return "ACCS";
+            if (contains("bracelets")) return "WRIST";
+            if (contains("ears")) return "TEETH";
+            if (contains("glasses")) return "PEYES";
+            if (contains("hats")) return "PHEAD";
+            if (contains("watch")) return "WRIST";
+            if (contains("mask")) return "BERD";
+            return "UNKNOWN";
+        }
+
+        // Times both detectors over `inputs` and compares their answers once
+        template <typename Legacy, typename Compiled>
+        bool compare(const char* name, const std::vector<std::string_view>& inputs, unsigned rounds,
+                     Legacy legacy, Compiled compiled, Core::ILogger& logger) {
+            size_t mismatches = 0;
+            for (std::string_view input : inputs) {
+                std::string_view expected = legacy(input);
+                std::string_view actual = compiled(input);
+                if (expected != actual && ++mismatches <= 5) {
+                    logger.error(std::string("Classifier mismatch (") + name + ") for " + std::string(input) +
+                                 ": " + std::string(expected) + " vs " + std::string(actual));
+                }
+            }
+
+            // The checksum keeps the loops from being optimized away
+            auto time = [&](auto classify, size_t& checksum) {
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned round = 0; round < rounds; ++round) {
+                    for (std::string_view input : inputs) {
+                        checksum += classify(input).size();
+                    }
+                }
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            };
+            size_t legacyChecksum = 0;
+            size_t compiledChecksum = 0;
+            double legacyMs = time(legacy, legacyChecksum);
+            double compiledMs = time(compiled, compiledChecksum);
+
+            logger.log(std::string("Classifier benchmark (") + name + "): " + std::to_string(inputs.size()) +
+                       " inputs x " + std::to_string(rounds) + " rounds, find() scans " + std::to_string(legacyMs) +
+                       " ms, compiled " + std::to_string(compiledMs) + " ms (" +
+                       std::to_string(compiledMs > 0 ? legacyMs / compiledMs : 0.0) + "x)" +
+                       (legacyChecksum == compiledChecksum ? "" : ", checksums differ"));
+            if (mismatches > 0) {
+                logger.error(std::string("Classifier benchmark (") + name + "): " + std::to_string(mismatches) +
+                             " of " + std::to_string(inputs.size()) + " inputs classified differently");
+            }
+            return mismatches == 0;
+        }
+    }
+
+    bool benchmarkComponentClassifier(const ClassifierBenchmarkInputs& inputs, unsigned rounds, Core::ILogger& logger) {
+        const auto& classifier = ComponentClassifier::instance();
+        bool same = compare("keys", inputs.keys, rounds, legacyKey, [&classifier](std::string_view key) {
+            const auto* comp = classifier.classifyKey(key);
+            return comp ? comp->displayName : std::string_view();
+        }, logger);
+        same = compare("hashes", inputs.hashes, rounds, legacyHash, [&classifier](std::string_view hash) {
+            const auto* comp = classifier.classifyHash(hash);
+            return comp ? comp->internalType : std::string_view();
+        }, logger) && same;
+        same = compare("file names", inputs.fileNames, rounds, legacyFileName, [&classifier](std::string_view name) {
+            return classifier.classifyFileName(name);
+        }, logger) && same;
+        return same;
+    }
+
+    bool benchmarkClassifierOnCorpus(std::shared_ptr<Core::ILogger> logger) {
+        XmlParser xmlParser(logger);
+        ScriptMetadataParser scriptParser(logger);
+        JsonParser jsonParser(logger);
+        if (!xmlParser.parse() || !scriptParser.parse() || !jsonParser.parse()) {
+            logger->error("Failed to parse the corpus in the working directory");
+            return false;
+        }
+
+        // Item keys carry the same component tokens as hashes, so they count as both
+        ClassifierBenchmarkInputs inputs;
+        for (const auto* items : { &scriptParser.getMaleItems(), &scriptParser.getFemaleItems() }) {
+            for (const auto& item : *items) {
+                inputs.keys.push_back(item.m_key);
+                inputs.hashes.push_back(item.m_key);
+            }
+        }
+        for (const auto* nodes : { &xmlParser.getMaleNodes(), &xmlParser.getFemaleNodes() }) {
+            for (const auto& node : *nodes) {
+                for (const auto& item : node.items) {
+                    inputs.hashes.push_back(item.uniqueNameHash);
+                }
+            }
+        }
+        for (const auto& file : jsonParser.getFileResults()) {
+            inputs.fileNames.push_back(Core::inputFileName(file.path));
+        }
+
+        constexpr unsigned ROUNDS = 20;
+        return benchmarkComponentClassifier(inputs, ROUNDS, *logger);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "Core/Interfaces.h"
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Tests {
+    // What the component detectors see in a run: script metadata keys, shop item hashes and
+    // JSON file names
+    struct ClassifierBenchmarkInputs {
+        std::vector<std::string_view> keys;
+        std::vector<std::string_view> hashes;
+        std::vector<std::string_view> fileNames;
+    };
+
+    // Classifies every input `rounds` times with ComponentClassifier and with the per-entry
+    // find() scans it replaced, logging both timings per detector. Returns false, after
+    // logging the first few, if any input gets a different answer.
+    bool benchmarkComponentClassifier(const ClassifierBenchmarkInputs& inputs, unsigned rounds, Core::ILogger& logger);
+
+    // Parses the corpus in the working directory as the tool does (without the snapshot) and
+    // benchmarks every script metadata key, shop item hash and JSON file name in it
+    bool benchmarkClassifierOnCorpus(std::shared_ptr<Core::ILogger> logger);
+}
@@ -0,0 +1,59 @@
+#include "TestSupport.h"
+#include "ClassifierBenchmark.h"
+#include "Core/ComponentClassifier.h"
+#include "Core/Constants.h"
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace {
+    using Core::ComponentTypes::FILE_NAME_COMPONENTS;
+    using Core::ComponentTypes::UNIFIED_COMPONENTS;
+
+    // Every table token in the places the detectors look for it, with the boundaries
+    // classifyHash distinguishes and in both cases
+    std::vector<std::string> tableSamples() {
+        std::vector<std::string> samples = { "", "_", "OUTFIT_X", "X_OUTFIT", "X_OUTFITS", "_JBIBX_JBIB_1" };
+        for (const auto& comp : UNIFIED_COMPONENTS) {
+            for (std::string_view token : { comp.legacyInFiles, comp.shortType, comp.internalType }) {
+                std::string text(token);
+                for (std::string sample : { "DLC_MP_BEACH_M_" + text + "_0", "X_" + text, "X_" + text + "7",
+                                            "X_" + text + "A", "X_" + text + "A_" + text + "_2" }) {
+                    samples.push_back(sample);
+                    for (char& c : sample) {
+                        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    }
+                    samples.push_back(sample);
+                }
+            }
+        }
+        for (const auto& [pattern, type] : FILE_NAME_COMPONENTS) {
+            samples.push_back("props_female_" + std::string(pattern) + ".json");
+            samples.push_back(std::string(pattern) + "_" + std::string(FILE_NAME_COMPONENTS[0].first) + ".json.gz");
+        }
+        return samples;
+    }
+}
+
+TEST_CASE(classifierAgreesWithFindScans) {
+    std::vector<std::string> samples = tableSamples();
+    Tests::ClassifierBenchmarkInputs inputs;
+    for (const auto& sample : samples) {
+        inputs.keys.push_back(sample);
+        inputs.hashes.push_back(sample);
+        inputs.fileNames.push_back(sample);
+    }
+    Tests::MemoryLogger logger;
+    CHECK(Tests::benchmarkComponentClassifier(inputs, 1, logger));
+}
+
+TEST_CASE(classifierSpotChecks) {
+    const auto& classifier = Core::ComponentClassifier::instance();
+    CHECK(classifier.classifyKey("DLC_MP_BEACH_M_JBIB_0") != nullptr);
+    CHECK(classifier.classifyKey("DLC_MP_BEACH_M_JBIB_0")->internalType == "TORSO_2");
+    CHECK(classifier.classifyHash("dlc_mp_h3_f_uppr_2_0") != nullptr);
+    CHECK(classifier.classifyHash("dlc_mp_h3_f_uppr_2_0")->internalType == "TORSO");
+    CHECK(classifier.classifyHash("DLC_F_UPPRX") == nullptr);
+    CHECK(classifier.classifyFileName("female_tops.json") == "JBIB");
+    CHECK(classifier.classifyFileName("female_socks.json") == "UNKNOWN");
+}
@@ -0,0 +1,106 @@
+#include "TestSupport.h"
+#include "Core/Compression.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    // gzip files written with zlib (raw deflate, then the trailer), one per block type
+
+    // Level 0: one stored block holding "tops.json"
+    constexpr char STORED[] =
+        "\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff\x01\x09\x00\xf6\xff\x74\x6f\x70\x73\x2e\x6a\x73\x6f\x6e"
+        "\x18\xf0\xe1\x17\x09\x00\x00\x00";
+    constexpr std::string_view STORED_TEXT = "tops.json";
+
+    // Z_FIXED: one block with the fixed Huffman codes, including back-references
+    constexpr char FIXED[] =
+        "\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff\x4b\x4c\x4a\x4e\x84\x21\x85\x8c\xd4\x9c\x9c\x7c\x08\x09"
+        "\x00\x38\x2f\x00\x52\x18\x00\x00\x00";
+    constexpr std::string_view FIXED_TEXT = "abcabcabcabc hello hello";
+
+    // Level 9: one block with dynamic Huffman codes
+    constexpr char DYNAMIC[] =
+        "\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff\x3d\xcd\xb9\x0d\xc0\x30\x0c\x43\xd1\x5d\x54\xa7\x90\xe4"
+        "\x33\x75\x5a\x03\x1e\x81\xfb\x6f\xe1\x04\x60\xd8\xbd\x86\x9f\xf6\xac\x0d\x87\xdb\x65\x9f\x02\x49"
+        "\x25\x2a\x55\xd0\xa9\x8a\x49\x35\xc4\x3f\xe9\x08\xca\x51\x94\x69\xca\x0c\x65\x6e\x65\x5c\x99\x54"
+        "\xe5\xbd\x3b\x44\x8d\x8d\xe0\x8d\x00\x00\x00";
+    constexpr std::string_view DYNAMIC_TEXT =
+        "\"CLO_0_0\",\"CLO_1_2\",\"CLO_2_4\",\"CLO_3_6\",\"CLO_4_8\",\"CLO_5_10\",\"CLO_6_1\",\"CLO_0_3\","
+        "\"CLO_1_5\",\"CLO_2_7\",\"CLO_3_9\",\"CLO_4_0\",\"CLO_5_2\",\"CLO_6_4\",";
+
+    template <size_t N>
+    std::string blob(const char (&data)[N]) {
+        return std::string(data, N - 1);
+    }
+
+    // The inflated text, or the error prefixed with "error: "
+    std::string gunzip(std::string_view input) {
+        std::vector<char> output;
+        std::string error;
+        if (!Core::Compression::gunzip(input, output, error)) {
+            return "error: " + error;
+        }
+        return std::string(output.begin(), output.end());
+    }
+
+    bool rejectsEveryPrefix(const std::string& input) {
+        for (size_t size = 0; size < input.size(); ++size) {
+            if (gunzip(std::string_view(input).substr(0, size)).rfind("error: ", 0) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE(gunzipStoredBlock) {
+    CHECK(Core::Compression::detect(blob(STORED)) == Core::Compression::Format::Gzip);
+    CHECK(gunzip(blob(STORED)) == STORED_TEXT);
+}
+
+TEST_CASE(gunzipFixedBlock) {
+    CHECK(gunzip(blob(FIXED)) == FIXED_TEXT);
+}
+
+TEST_CASE(gunzipDynamicBlock) {
+    CHECK(gunzip(blob(DYNAMIC)) == DYNAMIC_TEXT);
+}
+
+TEST_CASE(gunzipMultipleMembers) {
+    std::string expected = std::string(STORED_TEXT) + std::string(FIXED_TEXT) + std::string(DYNAMIC_TEXT);
+    CHECK(gunzip(blob(STORED) + blob(FIXED) + blob(DYNAMIC)) == expected);
+    CHECK(gunzip(blob(STORED) + blob(FIXED) + blob(DYNAMIC) + std::string(16, '\0')) == expected);
+    CHECK(gunzip(blob(STORED) + "garbage").rfind("error: ", 0) == 0);
+}
+
+TEST_CASE(gunzipTrailerMismatch) {
+    std::string badCrc = blob(DYNAMIC);
+    badCrc[badCrc.size() - 8] ^= 0x01;
+    CHECK(gunzip(badCrc) == "error: gzip CRC-32 mismatch");
+
+    std::string badLength = blob(DYNAMIC);
+    badLength[badLength.size() - 4] ^= 0x01;
+    CHECK(gunzip(badLength) == "error: gzip length mismatch");
+
+    // A trailer claiming 4 GB is only compared, never used to size the buffer
+    std::string hugeLength = blob(FIXED);
+    hugeLength.replace(hugeLength.size() - 4, 4, "\xff\xff\xff\xff");
+    CHECK(gunzip(hugeLength) == "error: gzip length mismatch");
+}
+
+TEST_CASE(gunzipTruncatedInput) {
+    CHECK(rejectsEveryPrefix(blob(STORED)));
+    CHECK(rejectsEveryPrefix(blob(FIXED)));
+    CHECK(rejectsEveryPrefix(blob(DYNAMIC)));
+    CHECK(gunzip(blob(FIXED).substr(0, blob(FIXED).size() - 8)) == "error: gzip trailer is truncated");
+}
+
+TEST_CASE(gunzipCorruptData) {
+    std::string input = blob(DYNAMIC);
+    for (size_t i = 10; i < input.size() - 8; ++i) {
+        std::string corrupt = input;
+        corrupt[i] ^= 0x5a;
+        CHECK(gunzip(corrupt) != DYNAMIC_TEXT);
+    }
+}
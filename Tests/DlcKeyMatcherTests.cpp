@@ -0,0 +1,51 @@
+#include "TestSupport.h"
+#include "Core/Constants.h"
+#include "Core/DlcKeyMatcher.h"
+#include <string_view>
+
+namespace {
+    // The DLC_LIST row the matcher returns for `text`, or nullptr
+    const Core::DlcInfo::DlcMapping* match(std::string_view text) {
+        return Core::DlcKeyMatcher::instance().match(text);
+    }
+
+    bool matches(std::string_view text, std::string_view dlcKey, std::string_view dlcFileName) {
+        const auto* dlc = match(text);
+        return dlc != nullptr && dlc->dlc_key == dlcKey && dlc->dlcFileName == dlcFileName;
+    }
+}
+
+TEST_CASE(dlcKeyPrefersLongerKey) {
+    CHECK(matches("DLC_MP_BUSI_M_JBIB_0", "DLC_MP_BUSI", "mpbusiness"));
+    CHECK(matches("DLC_MP_BUSI2_M_JBIB_0", "DLC_MP_BUSI2", "mpbusiness2"));
+
+    CHECK(matches("DLC_MP_AR_F_LEGS_3", "DLC_MP_AR", "mpairraces"));
+    CHECK(matches("DLC_MP_ARENA_F_LEGS_3", "DLC_MP_ARENA", "mpchristmas2018"));
+
+    CHECK(matches("DLC_MP_LOW_M_FEET_1", "DLC_MP_LOW", "mplowrider"));
+    CHECK(matches("DLC_MP_LOW2_M_FEET_1", "DLC_MP_LOW2", "mplowrider2"));
+
+    CHECK(matches("DLC_MP_LUXE_F_HAIR_0", "DLC_MP_LUXE", "mpluxe"));
+    CHECK(matches("DLC_MP_LUXE2_F_HAIR_0", "DLC_MP_LUXE2", "mpluxe2"));
+    CHECK(matches("MP_DLC_LUXE_F_HAIR_0", "MP_DLC_LUXE", "mpluxe"));
+}
+
+TEST_CASE(dlcKeyXmasUpdates) {
+    CHECK(matches("DLC_MP_XMAS_M_BERD_0", "DLC_MP_XMAS", "mpchristmas"));
+    CHECK(matches("DLC_MP_XMAS2_M_BERD_0", "DLC_MP_XMAS2", "mpchristmas2"));
+    CHECK(matches("DLC_MP_XMAS3_M_BERD_0", "DLC_MP_XMAS3", "mpxmas_604490"));
+    CHECK(matches("DLC_MP_XMAS4_M_BERD_0", "DLC_MP_XMAS", "mpchristmas"));
+}
+
+TEST_CASE(dlcKeyLongestAnywhereInText) {
+    // The longest key wins wherever it occurs, not the first one found
+    CHECK(matches("DLC_MP_AR_X_DLC_MP_ARENA", "DLC_MP_ARENA", "mpchristmas2018"));
+    CHECK(matches("DLC_MP_BUSI2_X_DLC_MP_BUSI", "DLC_MP_BUSI2", "mpbusiness2"));
+}
+
+TEST_CASE(dlcKeyWithoutMatch) {
+    CHECK(match("") == nullptr);
+    CHECK(match("CLO_SBF_E_0_9") == nullptr);
+    CHECK(match("dlc_mp_busi_m_jbib_0") == nullptr);
+    CHECK(match("DLC_MP_") == nullptr);
+}
@@ -0,0 +1,33 @@
+#include "TestSupport.h"
+#include "Core/ModelIds.h"
+#include <stdexcept>
+
+using namespace Core;
+
+TEST_CASE(componentNameKindsAreSeparate) {
+    ComponentTypes::ComponentId byDisplayName = ModelIds::componentOfDisplayName("TESTS_EXTRA_COMPONENT");
+    ComponentTypes::ComponentId byType = ModelIds::componentOfType("TESTS_EXTRA_COMPONENT");
+    CHECK(byDisplayName >= ComponentTypes::COMPONENT_COUNT);
+    CHECK(byType >= ComponentTypes::COMPONENT_COUNT);
+    CHECK(byDisplayName != byType);
+    CHECK(ModelIds::componentDisplayName(byDisplayName) == "TESTS_EXTRA_COMPONENT");
+    CHECK(ModelIds::componentType(byType) == "TESTS_EXTRA_COMPONENT");
+    CHECK(ModelIds::componentIdCount() > byDisplayName && ModelIds::componentIdCount() > byType);
+
+    bool threw = false;
+    try {
+        ModelIds::componentType(byDisplayName);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+TEST_CASE(reservedComponentsResolveBothWays) {
+    CHECK(ModelIds::componentOfType("") == ComponentTypes::NO_COMPONENT);
+    CHECK(ModelIds::componentOfDisplayName("") == ComponentTypes::NO_COMPONENT);
+    CHECK(ModelIds::componentOfType(Defaults::UNKNOWN_COMPONENT) == ComponentTypes::UNSET_COMPONENT);
+    CHECK(ModelIds::componentOfDisplayName(Defaults::UNKNOWN_COMPONENT) == ComponentTypes::UNSET_COMPONENT);
+    CHECK(ModelIds::componentType(ComponentTypes::UNSET_COMPONENT) == Defaults::UNKNOWN_COMPONENT);
+    CHECK(ModelIds::componentDisplayName(ComponentTypes::NO_COMPONENT).empty());
+}
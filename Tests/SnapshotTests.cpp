@@ -0,0 +1,86 @@
+#include "TestSupport.h"
+#include "Core/Constants.h"
+#include "Parsers/CorpusSnapshot.h"
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    using Core::ComponentTypes::FILE_NAME_COMPONENTS;
+    using Core::ComponentTypes::UNIFIED_COMPONENTS;
+    using Core::DlcInfo::DLC_LIST;
+    using Core::DlcInfo::SHOP_META_ALIASES;
+
+    template <typename Table>
+    auto copyOf(const Table& table) {
+        return std::vector<std::remove_const_t<std::remove_reference_t<decltype(table[0])>>>(std::begin(table), std::end(table));
+    }
+
+    // The fingerprint a build would have after the DLC_UPDATE_GUIDE edit of adding a DLC
+    uint64_t fingerprintWithAddedDlc() {
+        auto dlcs = copyOf(DLC_LIST);
+        dlcs.push_back({ "Test DLC", "DLC_MP_TEST", "mptest" });
+        return Core::Tables::fingerprint(UNIFIED_COMPONENTS, FILE_NAME_COMPONENTS, dlcs, SHOP_META_ALIASES);
+    }
+
+    std::string writeEmptySnapshot(const char* name, uint64_t tables) {
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        Tests::MemoryLogger logger;
+        auto parserLogger = std::make_shared<Tests::MemoryLogger>();
+        JsonParser jsonParser(parserLogger);
+        XmlParser xmlParser(parserLogger);
+        ScriptMetadataParser scriptParser(parserLogger);
+        CHECK(CorpusSnapshot::write(path, jsonParser, xmlParser, scriptParser, logger, tables));
+        return path;
+    }
+}
+
+TEST_CASE(fingerprintFollowsEveryTable) {
+    CHECK(Core::Tables::fingerprint(copyOf(UNIFIED_COMPONENTS), copyOf(FILE_NAME_COMPONENTS), copyOf(DLC_LIST),
+                                    copyOf(SHOP_META_ALIASES)) == Core::Tables::FINGERPRINT);
+
+    auto components = copyOf(UNIFIED_COMPONENTS);
+    components[0].shortType = "HEAD2";
+    CHECK(Core::Tables::fingerprint(components, FILE_NAME_COMPONENTS, DLC_LIST, SHOP_META_ALIASES) !=
+          Core::Tables::FINGERPRINT);
+
+    auto fileNames = copyOf(FILE_NAME_COMPONENTS);
+    fileNames[0].second = "TASK";
+    CHECK(Core::Tables::fingerprint(UNIFIED_COMPONENTS, fileNames, DLC_LIST, SHOP_META_ALIASES) !=
+          Core::Tables::FINGERPRINT);
+
+    auto dlcs = copyOf(DLC_LIST);
+    dlcs[0].name = "Beach Bum";
+    CHECK(Core::Tables::fingerprint(UNIFIED_COMPONENTS, FILE_NAME_COMPONENTS, dlcs, SHOP_META_ALIASES) !=
+          Core::Tables::FINGERPRINT);
+
+    auto aliases = copyOf(SHOP_META_ALIASES);
+    aliases[0].second = "mpimpexp";
+    CHECK(Core::Tables::fingerprint(UNIFIED_COMPONENTS, FILE_NAME_COMPONENTS, DLC_LIST, aliases) !=
+          Core::Tables::FINGERPRINT);
+
+    CHECK(fingerprintWithAddedDlc() != Core::Tables::FINGERPRINT);
+}
+
+TEST_CASE(snapshotLoadsWithSameTables) {
+    std::string path = writeEmptySnapshot("gsd_test_same_tables.snapshot", Core::Tables::FINGERPRINT);
+    auto logger = std::make_shared<Tests::MemoryLogger>();
+    CorpusSnapshot snapshot(logger);
+    bool loaded = snapshot.load(path);
+    std::filesystem::remove(path);
+    CHECK(loaded);
+}
+
+TEST_CASE(snapshotRejectedAfterTableEdit) {
+    // Written before a DLC was added to DLC_LIST, read by the build that has it
+    std::string path = writeEmptySnapshot("gsd_test_table_edit.snapshot", Core::Tables::FINGERPRINT);
+    auto logger = std::make_shared<Tests::MemoryLogger>();
+    CorpusSnapshot snapshot(logger, nullptr, fingerprintWithAddedDlc());
+    bool loaded = snapshot.load(path);
+    std::filesystem::remove(path);
+    CHECK(!loaded);
+    CHECK(snapshot.fileCount() == 0);
+    CHECK(logger->contains("different DLC or component tables"));
+}
@@ -0,0 +1,73 @@
+#include "TestSupport.h"
+#include "ClassifierBenchmark.h"
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace Tests {
+    namespace {
+        std::vector<std::pair<const char*, TestFunction>>& registry() {
+            static std::vector<std::pair<const char*, TestFunction>> tests;
+            return tests;
+        }
+    }
+
+    bool registerTest(const char* name, TestFunction run) {
+        registry().emplace_back(name, run);
+        return true;
+    }
+
+    void ConsoleLogger::log(const std::string& message) {
+        std::cout << message << std::endl;
+    }
+
+    void ConsoleLogger::error(const std::string& message) {
+        std::cout << "Error: " << message << std::endl;
+    }
+
+    void MemoryLogger::log(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back(message);
+    }
+
+    void MemoryLogger::error(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back("Error: " + message);
+    }
+
+    bool MemoryLogger::contains(const std::string& text) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& message : messages) {
+            if (message.find(text) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string_view(argv[1]) == "--bench-classifier") {
+        return Tests::benchmarkClassifierOnCorpus(std::make_shared<Tests::ConsoleLogger>()) ? 0 : 1;
+    }
+
+    size_t failed = 0;
+    for (const auto& [name, run] : Tests::registry()) {
+        try {
+            run();
+            std::cout << "[ OK ] " << name << std::endl;
+        }
+        catch (const Tests::Failure& failure) {
+            ++failed;
+            std::cout << "[FAIL] " << name << ": " << failure.message << std::endl;
+        }
+        catch (const std::exception& e) {
+            ++failed;
+            std::cout << "[FAIL] " << name << ": exception: " << e.what() << std::endl;
+        }
+    }
+    std::cout << Tests::registry().size() - failed << " of " << Tests::registry().size() << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Core/Interfaces.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Minimal self-registering test cases: TEST_CASE defines one, CHECK fails it with the
+// expression and its location, and TestMain runs every registered case. With
+// --bench-classifier it benchmarks the component classifier on the corpus in the
+// working directory instead.
+namespace Tests {
+    struct Failure {
+        std::string message;
+    };
+
+    using TestFunction = void (*)();
+
+    bool registerTest(const char* name, TestFunction run);
+
+    class ConsoleLogger : public Core::ILogger {
+    public:
+        void log(const std::string& message) override;
+        void error(const std::string& message) override;
+    };
+
+    // Keeps every message so a test can look for the one it expects
+    class MemoryLogger : public Core::ILogger {
+    public:
+        void log(const std::string& message) override;
+        void error(const std::string& message) override;
+
+        bool contains(const std::string& text) const;
+
+    private:
+        mutable std::mutex mutex;
+        std::vector<std::string> messages;
+    };
+}
+
+#define TEST_CASE(name)                                                        \
+    static void name();                                                        \
+    static const bool name##Registered = Tests::registerTest(#name, name);    \
+    static void name()
+
+#define CHECK(condition)                                                                     \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            throw Tests::Failure{ std::string(__FILE__) + ":" + std::to_string(__LINE__) +  \
+                                  ": CHECK(" #condition ") failed" };                        \
+        }                                                                                    \
+    } while (0)